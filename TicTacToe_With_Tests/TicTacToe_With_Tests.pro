@@ -4,8 +4,12 @@ TEMPLATE = subdirs
 
 # List the subdirectories that contain the other .pro files.
 # qmake will automatically find app.pro in the 'app' folder and tests.pro in the 'tests' folder.
-SUBDIRS = app
+SUBDIRS = app tests selfplay benchmarks
 # This is a crucial line. It tells Qt to always build the 'app'
 # project before it builds the 'tests' project, because the tests
 # depend on the code from the app.
 tests.depends = app
+
+# The self-play harness and the benchmarks compile the engines from the app sources as well
+selfplay.depends = app
+benchmarks.depends = app
@@ -1,40 +1,264 @@
 #include "AIPlayer.h"
+#include "SolvedTable.h"
+#include "GridSearch.h"
+#include <QElapsedTimer>
 #include <QRandomGenerator>
+#include <QThread>
+#include <QTimer>
 #include <QDebug>
 #include <algorithm>
+#include <type_traits>
 
-AIPlayer::AIPlayer(QObject *parent) : QObject(parent), aiMoveDelayTimer(new QTimer(this)) {
-    aiMoveDelayTimer->setSingleShot(true);
-    connect(aiMoveDelayTimer, &QTimer::timeout, this, [this]() {
-        QPoint move;
-        if (currentDifficulty == "easy") {
-            move = findRandomMove(currentAiBoard.getBoardState());
-        } else if (currentDifficulty == "medium") { // NEW: Handle medium difficulty
-            move = findMediumMove(currentAiBoard.getBoardState());
-        } else { // Hard difficulty
-            move = findBestMove(currentAiBoard.getBoardState());
+namespace {
+// Default pause between the AI being asked to move and the move appearing on the board
+constexpr int DEFAULT_PRESENTATION_DELAY_MS = 500;
+
+// Human replies searched ahead by ponder(), most promising first
+constexpr int PONDER_REPLIES = 4;
+
+// Below this, evaluatePositions stays on the calling thread; the work is done before threads would start
+constexpr std::size_t PARALLEL_BATCH_MIN = 1 << 16;
+
+// Default per-move search budget; the 3x3 board never gets close, larger boards stop here
+constexpr qint64 DEFAULT_TIME_BUDGET_MS = 1000;
+
+// XORed into the position hash when O (the maximizing side) is to move
+constexpr Board::Hash SIDE_TO_MOVE_KEY = 0xA5F1E3C2B4D69788ULL;
+
+// Spreads an 18-bit canonical position over 64 bits (splitmix64 finalizer, a bijection, so keys never collide)
+inline Board::Hash mixCanonicalKey(Board::PackedPosition key) {
+    Board::Hash z = key;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+}
+
+AIPlayer::AIPlayer(QObject *parent)
+    : QObject(parent), mctsSeed(QRandomGenerator::global()->generate64()), presentationDelayMs(DEFAULT_PRESENTATION_DELAY_MS),
+    random(QRandomGenerator::global()->generate()) {
+    searchPool.setMaxThreadCount(1);
+    searchLimits.timeBudgetMs = DEFAULT_TIME_BUDGET_MS;
+    qRegisterMetaType<SearchStats>(); // searchStatsReady may be connected across threads
+}
+
+AIPlayer::~AIPlayer() {
+    cancelPendingMove();
+    searchPool.waitForDone(); // The worker uses this object's tables, so let it finish first
+}
+
+void AIPlayer::makeMove(const AnyBoard& currentBoard, const QString& difficulty) {
+    const quint64 generation = ++searchGeneration; // Also tells any older search to stop
+    const SearchLimits limits = searchLimits;
+    const int threads = searchThreads;
+    const int presentationDelay = presentationDelayMs;
+    requestPending = true;
+    QElapsedTimer requestTime;
+    requestTime.start();
+
+    searchPool.start([this, board = currentBoard, difficulty, generation, limits, threads, presentationDelay,
+                      requestTime]() {
+        if (generation != searchGeneration.load()) {
+            return; // Cancelled while queued
         }
-        emit moveDetermined(move);
+        searchControl.setLimits(limits);
+        searchControl.setCancellation(&searchGeneration, generation);
+        activeSearchThreads = threads;
+
+        // A pondered answer for exactly this position is as good as searching again
+        QPoint move(-1, -1);
+        bool pondered = false;
+        for (const PonderedMove& entry : ponderCache) {
+            if (entry.hash == board.getHash() && entry.difficulty == difficulty) {
+                move = entry.move;
+                pondered = true;
+                ++ponderHits;
+                break;
+            }
+        }
+        ponderCache.clear();
+        if (pondered) {
+            searchStats = SearchStats();
+            searchStats.precomputed = true;
+        } else {
+            move = searchMove(board, difficulty);
+        }
+        const SearchStats stats = searchStats;
+
+        // Back on the GUI thread: only a result for the latest request may be emitted
+        QMetaObject::invokeMethod(this, [this, move, stats, generation, presentationDelay, requestTime]() {
+            if (generation != searchGeneration.load()) {
+                return;
+            }
+            // The presentation delay counts the time already spent searching
+            const qint64 remaining = std::max<qint64>(0, presentationDelay - requestTime.elapsed());
+            QTimer::singleShot(static_cast<int>(remaining), this, [this, move, stats, generation]() {
+                if (generation == searchGeneration.load()) {
+                    requestPending = false;
+                    reportedStats = stats;
+                    emit searchStatsReady(stats);
+                    emit moveDetermined(move);
+                }
+            });
+        }, Qt::QueuedConnection);
     });
 }
 
-void AIPlayer::makeMove(const Board& currentBoard, const QString& difficulty) {
-    currentAiBoard = currentBoard;
-    currentDifficulty = difficulty;
-    aiMoveDelayTimer->start(500);
+void AIPlayer::setRandomSeed(quint64 seed) {
+    random.seed(static_cast<quint32>(seed ^ (seed >> 32)));
+    mctsSeed = seed;
+    std::apply([seed](auto&... engines) {
+        ((engines ? engines->reseed(seed) : void()), ...); // The others are created from mctsSeed on first use
+    }, mctsEngines);
+}
+
+void AIPlayer::clearTables() {
+    transpositionTable.clear();
+    gridTable.clear();
+    ponderCache.clear();
+    std::apply([](auto&... engines) {
+        ((engines ? engines->clearTree() : void()), ...);
+    }, mctsEngines);
+}
+
+QPoint AIPlayer::computeMove(const AnyBoard& board, const QString& difficulty, int player) {
+    searchControl.setLimits(searchLimits);
+    searchControl.setCancellation(nullptr, 0);
+    activeSearchThreads = searchThreads;
+    QPoint move;
+    if (player == Board::PLAYER_O) {
+        move = searchMove(board, difficulty);
+        reportedStats = searchStats;
+        return move;
+    }
+
+    // Every engine plays O, and the rules are the same for both sides: hand it the board with the colours swapped
+    AnyBoard swapped(board.getVariant());
+    for (int row = 0; row < board.size(); ++row) {
+        for (int col = 0; col < board.size(); ++col) {
+            const int cell = board.getCell(row, col);
+            if (cell != Board::EMPTY) {
+                swapped.makeMove(row, col, -cell);
+            }
+        }
+    }
+    move = searchMove(swapped, difficulty);
+    reportedStats = searchStats;
+    return move;
+}
+
+SearchStats AIPlayer::perft(const AnyBoard& board, int player, int maxDepth) {
+    SearchStats stats;
+    QElapsedTimer timer;
+    timer.start();
+    board.visit([player, maxDepth, &stats](const auto& concrete) {
+        auto scratch = concrete; // Searched in place with make/unmake
+        ::perft(scratch, player, maxDepth, stats);
+    });
+    stats.elapsedNanoseconds = timer.nsecsElapsed();
+    return stats;
+}
+
+void AIPlayer::evaluatePositions(const Board::PackedPosition* positions, std::size_t count,
+                                 SolvedTable::Evaluation* results, int threads) {
+    if (threads <= 0) {
+        threads = QThread::idealThreadCount();
+    }
+    if (threads <= 1 || count < PARALLEL_BATCH_MIN) {
+        SolvedTable::evaluate(positions, count, results);
+        return;
+    }
+
+    // One contiguous slice per thread; the slices never overlap, so no locking is needed
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    const std::size_t slice = (count + threads - 1) / threads;
+    for (std::size_t begin = 0; begin < count; begin += slice) {
+        const std::size_t size = std::min(slice, count - begin);
+        pool.start([positions, results, begin, size]() {
+            SolvedTable::evaluate(positions + begin, size, results + begin);
+        });
+    }
+    pool.waitForDone();
+}
+
+void AIPlayer::cancelPendingMove() {
+    ++searchGeneration;
+    requestPending = false;
+}
+
+void AIPlayer::ponder(const AnyBoard& boardAfterAiMove, const QString& difficulty) {
+    if (!ponderingEnabled || requestPending || boardAfterAiMove.classic() ||
+        (difficulty != "hard" && difficulty != "mcts")) {
+        return; // The 3x3 answers come from the solved table, and easy/medium do not search
+    }
+    const quint64 generation = ++searchGeneration; // Nothing is pending, so this only stops an older ponder
+    const SearchLimits limits = searchLimits;
+    const int threads = searchThreads;
+
+    searchPool.start([this, board = boardAfterAiMove, difficulty, generation, limits, threads]() {
+        if (generation != searchGeneration.load()) {
+            return; // The human already moved
+        }
+        searchControl.setLimits(limits);
+        searchControl.setCancellation(&searchGeneration, generation);
+        activeSearchThreads = threads;
+        ponderCache.clear();
+        searchControl.beginSharedDeadline(); // All replies together get one move's time, not one each
+        searchControl.start(); // The replies search copies, so this is what checkNow() below sees
+        board.visit([this, &difficulty, generation](const auto& concrete) {
+            ponderReplies(concrete, difficulty, generation);
+        });
+        searchControl.endSharedDeadline();
+    });
+}
+
+QPoint AIPlayer::chooseMove(const AnyBoard& board, const QString& difficulty) {
+    if (difficulty == "mcts") {
+        return board.visit([this](const auto& concrete) { return findMctsMove(concrete); });
+    }
+    if (const Board* classic = board.classic()) {
+        if (difficulty == "easy") {
+            return findRandomMove(*classic);
+        } else if (difficulty == "medium") { // NEW: Handle medium difficulty
+            return findMediumMove(*classic);
+        } else { // Hard difficulty
+            return findBestMove(*classic);
+        }
+    }
+    // Larger variants: dispatch on the concrete GridBoard type
+    return board.visit([this, &difficulty](const auto& grid) { return findGridMove(grid, difficulty); });
+}
+
+QPoint AIPlayer::searchMove(const AnyBoard& board, const QString& difficulty) {
+    searchStats = SearchStats();
+    nodesVisited = 0;
+    const TranspositionTable::Stats tableBefore = transpositionTable.stats();
+    QElapsedTimer timer;
+    timer.start();
+
+    const QPoint move = chooseMove(board, difficulty);
+
+    searchStats.elapsedNanoseconds = timer.nsecsElapsed();
+    searchStats.nodes = nodesVisited;
+    // The 3x3 table counts its own probes; the larger boards' searches fill these in themselves
+    searchStats.tableProbes += transpositionTable.stats().probes - tableBefore.probes;
+    searchStats.tableHits += transpositionTable.stats().hits - tableBefore.hits;
+    return move;
 }
 
 // NEW: Implementation for the medium difficulty AI
-QPoint AIPlayer::findMediumMove(std::vector<std::vector<int>> board) {
+QPoint AIPlayer::findMediumMove(const Board& board) {
+    Board scratch = board; // Stack copy; moves are tried and undone in place
+
     // Priority 1: Check if AI can win in the next move
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
-            if (board[i][j] == Board::EMPTY) {
-                board[i][j] = Board::PLAYER_O; // Try AI move
-                if (evaluateBoard(board) == 10) {
+            if (scratch.makeMove(i, j, Board::PLAYER_O)) { // Try AI move
+                if (evaluateBoard(scratch) == 10) {
                     return QPoint(i, j); // Return winning move
                 }
-                board[i][j] = Board::EMPTY; // Undo move
+                scratch.undoMove(i, j); // Undo move
             }
         }
     }
@@ -42,12 +266,11 @@ QPoint AIPlayer::findMediumMove(std::vector<std::vector<int>> board) {
     // Priority 2: Check if the player could win, and block them
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
-            if (board[i][j] == Board::EMPTY) {
-                board[i][j] = Board::PLAYER_X; // Try Player move
-                if (evaluateBoard(board) == -10) {
+            if (scratch.makeMove(i, j, Board::PLAYER_X)) { // Try Player move
+                if (evaluateBoard(scratch) == -10) {
                     return QPoint(i, j); // Return blocking move
                 }
-                board[i][j] = Board::EMPTY; // Undo move
+                scratch.undoMove(i, j); // Undo move
             }
         }
     }
@@ -57,82 +280,128 @@ QPoint AIPlayer::findMediumMove(std::vector<std::vector<int>> board) {
 }
 
 
-int AIPlayer::evaluateBoard(std::vector<std::vector<int>> board) {
-    // Check rows
-    for (int r = 0; r < 3; ++r) {
-        if (board[r][0] == board[r][1] && board[r][1] == board[r][2] && board[r][0] != Board::EMPTY) {
-            return (board[r][0] == Board::PLAYER_O) ? 10 : -10;
+int AIPlayer::evaluateBoard(const Board& board) const {
+    // The bitboard check covers rows, columns and both diagonals
+    const int winner = board.checkWin();
+    if (winner == Board::PLAYER_O) return 10;
+    if (winner == Board::PLAYER_X) return -10;
+    return 0; // No winner
+}
+
+bool AIPlayer::isMovesLeft(const Board& board) const {
+    return !board.isFull();
+}
+
+int AIPlayer::minimax(Board& board, int depth, bool isMaximizingPlayer, int alpha, int beta) {
+    ++nodesVisited;
+    if (searchControl.shouldStop(nodesVisited)) {
+        return 0; // Out of budget or cancelled; the caller discards this iteration
+    }
+    SEARCH_STAT(searchStats.recordNode(depth + 1));
+    const int score = evaluateBoard(board);
+    // Won, full, or at the horizon of this iteration (depth 0 is one ply below the root), where 0 means undecided
+    if (score != 0 || !isMovesLeft(board) || depth + 1 >= depthLimit) {
+        SEARCH_STAT(++searchStats.leafEvaluations);
+        return score;
+    }
+
+    // Scores do not depend on the path taken or on board symmetry, so the table is keyed on the
+    // canonical (D4-minimal) position and any earlier search of a rotated/reflected copy is reused
+    const Board::CanonicalForm canonical = board.canonicalForm();
+    const Board::Hash key = mixCanonicalKey(canonical.key) ^ (isMaximizingPlayer ? SIDE_TO_MOVE_KEY : 0);
+    // Plies this node is searched to; an entry only answers for a search at least as deep
+    const int remainingDepth = std::min(depthLimit - depth - 1, 9 - Board::countCells(board.getOccupiedMask()));
+    const int alphaOrig = alpha;
+    const int betaOrig = beta;
+    int cachedMove = -1;
+    if (const TranspositionTable::Entry* entry = transpositionTable.probe(key)) {
+        if (entry->bestMove >= 0) {
+            cachedMove = Board::inverseTransformCell(entry->bestMove, canonical.transform);
         }
+        if (entry->depth >= remainingDepth) {
+            if (entry->bound == TranspositionTable::EXACT) return entry->score;
+            if (entry->bound == TranspositionTable::LOWER_BOUND) alpha = std::max(alpha, int(entry->score));
+            if (entry->bound == TranspositionTable::UPPER_BOUND) beta = std::min(beta, int(entry->score));
+            if (beta <= alpha) return entry->score;
+        }
+    }
+
+    // Try the cached best move first, then the remaining cells in row-major order
+    int order[9];
+    int moveCount = 0;
+    if (cachedMove >= 0) order[moveCount++] = cachedMove;
+    for (int cell = 0; cell < 9; ++cell) {
+        if (cell != cachedMove) order[moveCount++] = cell;
     }
-    // Check columns
-    for (int c = 0; c < 3; ++c) {
-        if (board[0][c] == board[1][c] && board[1][c] == board[2][c] && board[0][c] != Board::EMPTY) {
-            return (board[0][c] == Board::PLAYER_O) ? 10 : -10;
+
+    const int player = isMaximizingPlayer ? Board::PLAYER_O : Board::PLAYER_X;
+    int best = isMaximizingPlayer ? -1000 : 1000;
+    int bestMove = -1;
+    for (int k = 0; k < moveCount; ++k) {
+        const int i = order[k] / 3;
+        const int j = order[k] % 3;
+        if (!board.makeMove(i, j, player)) {
+            continue; // Cell already taken
+        }
+        const int value = minimax(board, depth + 1, !isMaximizingPlayer, alpha, beta);
+        board.undoMove(i, j);
+
+        if (isMaximizingPlayer ? value > best : value < best) {
+            best = value;
+            bestMove = order[k];
+        }
+        if (isMaximizingPlayer) {
+            alpha = std::max(alpha, best);
+        } else {
+            beta = std::min(beta, best);
+        }
+        if (beta <= alpha) {
+            SEARCH_STAT(searchStats.recordCutoff(depth + 1));
+            break;
         }
     }
-    // Check diagonals
-    if (board[0][0] == board[1][1] && board[1][1] == board[2][2] && board[0][0] != Board::EMPTY) {
-        return (board[0][0] == Board::PLAYER_O) ? 10 : -10;
+
+    if (searchControl.stopped()) {
+        return best; // Possibly incomplete, so keep it out of the table
     }
-    if (board[0][2] == board[1][1] && board[1][1] == board[2][0] && board[0][2] != Board::EMPTY) {
-        return (board[0][2] == Board::PLAYER_O) ? 10 : -10;
+
+    TranspositionTable::Bound bound = TranspositionTable::EXACT;
+    if (best <= alphaOrig) {
+        bound = TranspositionTable::UPPER_BOUND;
+    } else if (best >= betaOrig) {
+        bound = TranspositionTable::LOWER_BOUND;
     }
-    return 0; // No winner
+    const int canonicalMove = bestMove >= 0 ? Board::transformCell(bestMove, canonical.transform) : -1;
+    transpositionTable.store(key, best, remainingDepth, canonicalMove, bound);
+    return best;
 }
 
-bool AIPlayer::isMovesLeft(std::vector<std::vector<int>> board) {
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            if (board[i][j] == Board::EMPTY)
-                return true;
-    return false;
-}
-
-int AIPlayer::minimax(std::vector<std::vector<int>> board, int depth, bool isMaximizingPlayer, int alpha, int beta) {
-    int score = evaluateBoard(board);
-    if (score == 10) return score;
-    if (score == -10) return score;
-    if (!isMovesLeft(board)) return 0;
-
-    if (isMaximizingPlayer) {
-        int best = -1000;
-        for (int i = 0; i < 3; ++i) {
-            for (int j = 0; j < 3; ++j) {
-                if (board[i][j] == Board::EMPTY) {
-                    board[i][j] = Board::PLAYER_O;
-                    best = std::max(best, minimax(board, depth + 1, false, alpha, beta));
-                    board[i][j] = Board::EMPTY;
-                    alpha = std::max(alpha, best);
-                    if (beta <= alpha)
-                        break;
-                }
-            }
-            if (beta <= alpha)
-                break;
-        }
-        return best;
-    }
-    else {
-        int best = 1000;
-        for (int i = 0; i < 3; ++i) {
-            for (int j = 0; j < 3; ++j) {
-                if (board[i][j] == Board::EMPTY) {
-                    board[i][j] = Board::PLAYER_X;
-                    best = std::min(best, minimax(board, depth + 1, true, alpha, beta));
-                    board[i][j] = Board::EMPTY;
-                    beta = std::min(beta, best);
-                    if (beta <= alpha)
-                        break;
-                }
+QPoint AIPlayer::findBestMove(const Board& currentBoard) {
+    // Any position from a normal game (X first) is answered by the compile-time solved table
+    int tableMove = SolvedTable::bestMove(currentBoard, Board::PLAYER_O);
+    if (tableMove < 0) {
+        // In a game O opened, O's position is X's position in the table with the colours swapped
+        Board swapped;
+        for (int cell = 0; cell < 9; ++cell) {
+            const int mark = currentBoard.getCell(cell / 3, cell % 3);
+            if (mark != Board::EMPTY) {
+                swapped.makeMove(cell / 3, cell % 3, -mark);
             }
-            if (beta <= alpha)
-                break;
         }
-        return best;
+        tableMove = SolvedTable::bestMove(swapped, Board::PLAYER_X);
+    }
+    if (tableMove >= 0) {
+        nodesVisited = 0;
+        searchStats.precomputed = true;
+        return QPoint(tableMove / 3, tableMove % 3);
     }
+    return searchBestMove(currentBoard);
 }
 
-QPoint AIPlayer::findBestMove(std::vector<std::vector<int>> board) {
+QPoint AIPlayer::searchBestMove(const Board& currentBoard) {
+    Board board = currentBoard; // The only copy made for the whole search
+    nodesVisited = 0;
+
     // Priority 1 & 2 are handled by findMediumMove, so we can reuse it for the opening checks.
     // QPoint immediateMove = findMediumMove(board);
     if(evaluateBoard(board) != 0) {
@@ -141,51 +410,79 @@ QPoint AIPlayer::findBestMove(std::vector<std::vector<int>> board) {
         // We can check this by seeing if making the move and evaluating it results in a win/loss.
         // This is a bit complex. A simpler way is to just run the checks here again.
         for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) {
-                if (board[i][j] == Board::EMPTY) {
-                    board[i][j] = Board::PLAYER_O;
+                if (board.makeMove(i, j, Board::PLAYER_O)) {
                     if (evaluateBoard(board) == 10) { return QPoint(i, j); }
-                    board[i][j] = Board::EMPTY;
+                    board.undoMove(i, j);
                 }
             }
         for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) {
-                if (board[i][j] == Board::EMPTY) {
-                    board[i][j] = Board::PLAYER_X;
+                if (board.makeMove(i, j, Board::PLAYER_X)) {
                     if (evaluateBoard(board) == -10) { return QPoint(i, j); }
-                    board[i][j] = Board::EMPTY;
+                    board.undoMove(i, j);
                 }
             }
     }
 
 
-    // Priority 3: If no immediate win/block, use minimax for optimal move
-    int bestVal = -1000;
-    QPoint bestMove(-1, -1);
-    int alpha = -1000;
-    int beta = 1000;
+    // Priority 3: If no immediate win/block, use minimax for optimal move.
+    // Iterative deepening: each iteration searches one ply deeper, seeded by the table entries of
+    // the last one, and only a finished iteration may replace the answer.
+    searchControl.start();
+    const int emptyCells = 9 - Board::countCells(board.getOccupiedMask());
+    const int maxDepth = searchControl.limits().maxDepth > 0 ? std::min(searchControl.limits().maxDepth, emptyCells)
+                                                             : emptyCells;
+    int bestCell = -1;
+    for (depthLimit = 1; depthLimit <= maxDepth; ++depthLimit) {
+        // Previous best first, then row-major order
+        int order[9];
+        int moveCount = 0;
+        if (bestCell >= 0) order[moveCount++] = bestCell;
+        for (int cell = 0; cell < 9; ++cell) {
+            if (cell != bestCell) order[moveCount++] = cell;
+        }
 
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (board[i][j] == Board::EMPTY) {
-                board[i][j] = Board::PLAYER_O;
-                int moveVal = minimax(board, 0, false, alpha, beta);
-                board[i][j] = Board::EMPTY;
-                if (moveVal > bestVal) {
-                    bestMove.setX(i);
-                    bestMove.setY(j);
-                    bestVal = moveVal;
-                }
-                alpha = std::max(alpha, bestVal);
+        int iterationValue = -1000;
+        int iterationCell = -1;
+        for (int k = 0; k < moveCount && !searchControl.checkNow(); ++k) {
+            const int cell = order[k];
+            if (!board.makeMove(cell / 3, cell % 3, Board::PLAYER_O)) {
+                continue;
+            }
+            // Ties go to the earliest cell in row-major order, so cells before the current best are
+            // searched with a window one point wider: that is enough to tell "equal" from "worse"
+            const int alpha = (iterationCell >= 0 && cell < iterationCell) ? iterationValue - 1 : iterationValue;
+            const int moveVal = minimax(board, 0, false, alpha, 1000);
+            board.undoMove(cell / 3, cell % 3);
+            if (searchControl.stopped()) {
+                break;
             }
+            if (moveVal > iterationValue || (moveVal == iterationValue && cell < iterationCell)) {
+                iterationValue = moveVal;
+                iterationCell = cell;
+            }
+        }
+        if (searchControl.stopped()) {
+            break; // Unfinished iteration: keep the previous answer
+        }
+        bestCell = iterationCell;
+        searchStats.completedDepth = depthLimit;
+    }
+    depthLimit = 9;
+
+    if (bestCell < 0) {
+        // Not even one iteration finished: fall back to the first empty cell
+        for (int cell = 0; cell < 9 && bestCell < 0; ++cell) {
+            if (board.getCell(cell / 3, cell % 3) == Board::EMPTY) bestCell = cell;
         }
     }
-    return bestMove;
+    return bestCell < 0 ? QPoint(-1, -1) : QPoint(bestCell / 3, bestCell % 3);
 }
 
-QPoint AIPlayer::findRandomMove(std::vector<std::vector<int>> board) {
+QPoint AIPlayer::findRandomMove(const Board& board) {
     QVector<QPoint> availableMoves;
     for (int i = 0; i < 3; ++i) {
         for (int j = 0; j < 3; ++j) {
-            if (board[i][j] == Board::EMPTY) {
+            if (board.getCell(i, j) == Board::EMPTY) {
                 availableMoves.append(QPoint(i, j));
             }
         }
@@ -193,5 +490,94 @@ QPoint AIPlayer::findRandomMove(std::vector<std::vector<int>> board) {
     if (availableMoves.isEmpty()) {
         return QPoint(-1, -1);
     }
-    return availableMoves[QRandomGenerator::global()->bounded(availableMoves.size())];
+    return availableMoves[random.bounded(availableMoves.size())];
+}
+
+template <typename BoardType>
+QPoint AIPlayer::findGridMove(const BoardType& board, const QString& difficulty) {
+    if constexpr (std::is_same_v<BoardType, Board>) {
+        Q_UNUSED(difficulty);
+        return findBestMove(board); // The classic board has its own table and search
+    } else {
+        if (difficulty == "easy") {
+            return GridSearch<BoardType>::findRandomMove(board, random);
+        }
+        // Deepens until the search limits run out, so large boards stay responsive
+        GridSearch<BoardType> search(searchControl);
+        search.setTranspositionTable(&gridTable);
+        if (activeSearchThreads > 1) {
+            helperPool.setMaxThreadCount(activeSearchThreads - 1);
+            search.setParallelism(&helperPool, activeSearchThreads - 1);
+        }
+        QPoint move = difficulty == "medium" ? search.findMediumMove(board, Board::PLAYER_O, random)
+                                             : search.findBestMove(board, Board::PLAYER_O);
+        nodesVisited = search.lastSearchNodeCount();
+        searchStats = search.lastSearchStats();
+        return move;
+    }
+}
+
+template <typename BoardType>
+void AIPlayer::ponderReplies(const BoardType& board, const QString& difficulty, quint64 generation) {
+    if constexpr (std::is_same_v<BoardType, Board>) {
+        Q_UNUSED(board);
+        Q_UNUSED(difficulty);
+        Q_UNUSED(generation);
+    } else {
+        if (difficulty == "mcts") {
+            // Searching the human's position grows the tree under every reply, and the real request
+            // re-roots into it; the rounds share the pass's deadline like the hard pondering below
+            for (int round = 0; round < PONDER_REPLIES && generation == searchGeneration.load(); ++round) {
+                searchControl.shareDeadlineAmong(PONDER_REPLIES - round);
+                mctsEngine<BoardType>().findBestMove(board, Board::PLAYER_X, searchControl);
+            }
+            return;
+        }
+
+        int replies[PONDER_REPLIES];
+        const int replyCount = GridSearch<BoardType>().rankMoves(board, Board::PLAYER_X, replies, PONDER_REPLIES);
+        for (int k = 0; k < replyCount && !searchControl.checkNow(); ++k) {
+            BoardType next = board;
+            next.makeMove(replies[k] / BoardType::SIZE, replies[k] % BoardType::SIZE, Board::PLAYER_X);
+            if (next.checkWin() != Board::EMPTY || next.isFull()) {
+                continue; // Game over; nothing to answer
+            }
+            searchControl.shareDeadlineAmong(replyCount - k); // Leaves time for the replies after this one
+            const QPoint answer = findGridMove(next, difficulty);
+            if (generation != searchGeneration.load()) {
+                return; // The real request arrived mid-search; that result is incomplete
+            }
+            ponderCache.push_back({next.getHash(), difficulty, answer});
+        }
+    }
+}
+
+template <typename BoardType>
+MctsEngine<BoardType>& AIPlayer::mctsEngine() {
+    std::unique_ptr<MctsEngine<BoardType>>& engine = std::get<std::unique_ptr<MctsEngine<BoardType>>>(mctsEngines);
+    if (!engine) {
+        engine = std::make_unique<MctsEngine<BoardType>>(mctsSeed);
+    }
+    return *engine;
+}
+
+template <typename BoardType>
+QPoint AIPlayer::findMctsMove(const BoardType& board) {
+    MctsEngine<BoardType>& engine = mctsEngine<BoardType>();
+    const QPoint move = engine.findBestMove(board, Board::PLAYER_O, searchControl);
+    mctsStats = engine.lastStats();
+    nodesVisited = mctsStats.iterations;
+    return move;
+}
+
+QPoint AIPlayer::findBestMove(const std::vector<std::vector<int>>& board) {
+    return findBestMove(Board::fromBoardState(board));
+}
+
+QPoint AIPlayer::findMediumMove(const std::vector<std::vector<int>>& board) {
+    return findMediumMove(Board::fromBoardState(board));
+}
+
+QPoint AIPlayer::findRandomMove(const std::vector<std::vector<int>>& board) {
+    return findRandomMove(Board::fromBoardState(board));
 }
@@ -5,9 +5,21 @@
 
 #include <QObject>
 #include <QPoint>
-#include <QTimer>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <tuple>
 #include <vector>
 #include "board.h"
+#include "AnyBoard.h"
+#include "ConcurrentTranspositionTable.h"
+#include "MctsEngine.h"
+#include "SearchControl.h"
+#include "SearchStats.h"
+#include "SolvedTable.h"
+#include "TranspositionTable.h"
 
 // Forward-declare the test class before using it.
 class TestAIPlayer;
@@ -22,26 +34,141 @@ class AIPlayer : public QObject
 
 public:
     explicit AIPlayer(QObject *parent = nullptr);
+    ~AIPlayer();
+
+    // Scores a contiguous array of packed 3x3 positions (Board::pack()) with perfect play, without any
+    // signals or timers. Batches large enough to pay for it are split over `threads` cores (0 = all).
+    static void evaluatePositions(const Board::PackedPosition* positions, std::size_t count,
+                                  SolvedTable::Evaluation* results, int threads = 0);
+
+    // Budget for each search; applies from the next makeMove call
+    void setSearchLimits(const SearchLimits& limits) { searchLimits = limits; }
+    const SearchLimits& getSearchLimits() const { return searchLimits; }
+
+    // Threads used by hard searches on the larger boards (root moves are split between them).
+    // 1, the default, keeps every search on the worker thread and its result reproducible.
+    void setSearchThreads(int threads) { searchThreads = std::max(1, threads); }
+    int getSearchThreads() const { return searchThreads; }
+
+    // Pondering: after the AI has moved, search the human's likely replies in the background so the
+    // answer to the real one is often ready at once. Only applies to hard and mcts on the larger boards.
+    void setPonderingEnabled(bool enabled) { ponderingEnabled = enabled; }
+    bool isPonderingEnabled() const { return ponderingEnabled; }
+    quint64 ponderHitCount() const { return ponderHits.load(); }
+
+    // Minimum time between a request and moveDetermined, so the AI does not answer instantly.
+    // Purely cosmetic; set it to 0 for headless runs and benchmarks.
+    void setPresentationDelay(int milliseconds) { presentationDelayMs = std::max(0, milliseconds); }
+    int getPresentationDelay() const { return presentationDelayMs; }
+
+    // Seeds the random choices (easy/medium moves, MCTS playouts) so a sequence of searches can be replayed.
+    // Seeded from the global generator by default; call before the first request.
+    void setRandomSeed(quint64 seed);
+    // Forgets what earlier searches learned (transposition tables, MCTS trees, pondered replies) without
+    // freeing the memory, so together with setRandomSeed the next game plays exactly as on a new AIPlayer.
+    // Only while no search is running, e.g. between computeMove games.
+    void clearTables();
+
+    // Picks a move for `player` on the calling thread and returns it: no worker, signals, timers or pondering.
+    // For headless drivers such as the self-play harness; not to be mixed with makeMove on the same object.
+    QPoint computeMove(const AnyBoard& board, const QString& difficulty, int player = Board::PLAYER_O);
+
+    // Nodes (or MCTS playouts) of the last search; 0 when a table answered
+    quint64 lastSearchNodeCount() const { return nodesVisited; }
+
+    // Counters of the last makeMove or computeMove search (also sent with searchStatsReady). Read it on the thread
+    // that asked for the move, once the move has arrived.
+    const SearchStats& lastSearchStats() const { return reportedStats; }
+
+    // Exhaustive game-tree count from board with player to move (see perft() in SearchStats.h)
+    static SearchStats perft(const AnyBoard& board, int player, int maxDepth = 0);
 
 public slots:
-    void makeMove(const Board& currentBoard, const QString& difficulty);
+    // Starts a search on the worker thread; the result arrives later through moveDetermined
+    void makeMove(const AnyBoard& currentBoard, const QString& difficulty);
+    // Drops any search that is queued or running; its result will never be emitted
+    void cancelPendingMove();
+    // Starts pondering on the position after the AI's move (the human to play); stopped by the next request
+    void ponder(const AnyBoard& boardAfterAiMove, const QString& difficulty);
 
 signals:
     void moveDetermined(const QPoint& move);
+    void searchStatsReady(const SearchStats& stats); // Emitted just before moveDetermined
 
 private:
+    // Picks a move for the given difficulty; runs on the worker thread
+    QPoint chooseMove(const AnyBoard& board, const QString& difficulty);
+    // chooseMove, timed and with searchStats filled in
+    QPoint searchMove(const AnyBoard& board, const QString& difficulty);
+
     // Your test now has access to these functions
-    QPoint findBestMove(std::vector<std::vector<int>> board);
-    QPoint findMediumMove(std::vector<std::vector<int>> board); // NEW: Medium difficulty move finder
-    QPoint findRandomMove(std::vector<std::vector<int>> board);
+    QPoint findBestMove(const Board& board);
+    QPoint findMediumMove(const Board& board); // NEW: Medium difficulty move finder
+    QPoint findRandomMove(const Board& board);
+
+    // Iteratively deepened alpha-beta search, used when the solved table cannot answer (and to cross-check it in tests)
+    QPoint searchBestMove(const Board& board);
+
+    // Easy/medium/hard for the larger GridBoard variants (iteratively deepened within the search limits)
+    template <typename BoardType>
+    QPoint findGridMove(const BoardType& board, const QString& difficulty);
+
+    // Searches the best few replies for PLAYER_X and caches the AI's answer to each
+    template <typename BoardType>
+    void ponderReplies(const BoardType& board, const QString& difficulty, quint64 generation);
+
+    // Monte Carlo tree search ("mcts" difficulty) on any board; the engine's tree is kept between moves
+    template <typename BoardType>
+    QPoint findMctsMove(const BoardType& board);
+    template <typename BoardType>
+    MctsEngine<BoardType>& mctsEngine();
+
+    // 2D-vector entry points kept for older callers; they convert once and use the Board versions
+    QPoint findBestMove(const std::vector<std::vector<int>>& board);
+    QPoint findMediumMove(const std::vector<std::vector<int>>& board);
+    QPoint findRandomMove(const std::vector<std::vector<int>>& board);
+
+    // The search works in place on one stack-resident Board (make/unmake), so no node allocates
+    // Positions depthLimit plies below the root are scored 0 (undecided); depth 0 is the root's child
+    int minimax(Board& board, int depth, bool isMaximizingPlayer, int alpha, int beta);
+    int evaluateBoard(const Board& board) const;
+    bool isMovesLeft(const Board& board) const;
+
+    const TranspositionTable::Stats& transpositionStats() const { return transpositionTable.stats(); }
+    const MctsStats& lastMctsStats() const { return mctsStats; }
 
-    int minimax(std::vector<std::vector<int>> board, int depth, bool isMaximizingPlayer, int alpha, int beta);
-    int evaluateBoard(std::vector<std::vector<int>> board);
-    bool isMovesLeft(std::vector<std::vector<int>> board);
+    QThreadPool searchPool;                  // Single worker: searches run one at a time, so the TT is never shared
+    std::atomic<quint64> searchGeneration{0}; // Bumped by every request and cancel; older results are stale
+    SearchControl searchControl;             // Stop condition of the search currently running on the worker
+    SearchLimits searchLimits;               // Set on the GUI thread, copied into searchControl per request
+    int searchThreads = 1;                   // Set on the GUI thread, copied into activeSearchThreads per request
+    int activeSearchThreads = 1;
+    QThreadPool helperPool;                  // Extra threads for the parallel root split
+    ConcurrentTranspositionTable gridTable;  // Shared by all threads of a GridBoard search, kept across moves
+    // One MCTS engine per board type, created on first use (each arena is a few MB)
+    std::tuple<std::unique_ptr<MctsEngine<Board>>,
+               std::unique_ptr<MctsEngine<AnyBoard::Grid4x4>>,
+               std::unique_ptr<MctsEngine<AnyBoard::Grid5x5>>,
+               std::unique_ptr<MctsEngine<AnyBoard::Gomoku15x15>>> mctsEngines;
+    quint64 mctsSeed;                        // Seed of each MCTS engine, set again by setRandomSeed
+    MctsStats mctsStats;
 
-    QTimer *aiMoveDelayTimer;
-    Board currentAiBoard;
-    QString currentDifficulty;
+    struct PonderedMove {
+        Board::Hash hash;   // Position after the human's reply
+        QString difficulty;
+        QPoint move;
+    };
+    bool ponderingEnabled = true;
+    bool requestPending = false;           // GUI thread: a real request has not been answered yet
+    std::vector<PonderedMove> ponderCache; // Worker thread only; refilled by each ponder
+    std::atomic<quint64> ponderHits{0};
+    int presentationDelayMs;
+    QRandomGenerator random;                 // Worker thread only (or the computeMove caller)
+    int depthLimit = 9;                      // Horizon of the current iteration in searchBestMove
+    quint64 nodesVisited = 0; // minimax nodes visited by the last search
+    SearchStats searchStats;   // Worker thread: counters of the search in progress (pondering included)
+    SearchStats reportedStats; // Requesting thread: counters of the last move delivered
+    TranspositionTable transpositionTable; // Kept across moves and games; results never go stale
 };
 
 #endif // AIPLAYER_H
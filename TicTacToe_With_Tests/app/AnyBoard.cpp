@@ -0,0 +1,54 @@
+#include "AnyBoard.h"
+
+AnyBoard::AnyBoard(BoardVariant variant) : variant(variant) {
+    switch (variant) {
+    case BoardVariant::Classic3x3:
+        board.emplace<Board>();
+        break;
+    case BoardVariant::Grid4x4:
+        board.emplace<Grid4x4>();
+        break;
+    case BoardVariant::Grid5x5:
+        board.emplace<Grid5x5>();
+        break;
+    case BoardVariant::Gomoku15x15:
+        board.emplace<Gomoku15x15>();
+        break;
+    }
+}
+
+int AnyBoard::size() const {
+    return visit([](const auto& b) { return std::decay_t<decltype(b)>::SIZE; });
+}
+
+int AnyBoard::winLength() const {
+    return visit([](const auto& b) { return std::decay_t<decltype(b)>::WIN_LENGTH; });
+}
+
+void AnyBoard::reset() {
+    visit([](auto& b) { b.reset(); });
+}
+
+bool AnyBoard::makeMove(int row, int col, int player) {
+    return visit([=](auto& b) { return b.makeMove(row, col, player); });
+}
+
+void AnyBoard::undoMove(int row, int col) {
+    visit([=](auto& b) { b.undoMove(row, col); });
+}
+
+int AnyBoard::getCell(int row, int col) const {
+    return visit([=](const auto& b) { return b.getCell(row, col); });
+}
+
+bool AnyBoard::isFull() const {
+    return visit([](const auto& b) { return b.isFull(); });
+}
+
+int AnyBoard::checkWin() const {
+    return visit([](const auto& b) { return b.checkWin(); });
+}
+
+Board::Hash AnyBoard::getHash() const {
+    return visit([](const auto& b) { return b.getHash(); });
+}
@@ -0,0 +1,54 @@
+#ifndef ANYBOARD_H
+#define ANYBOARD_H
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "board.h"
+#include "GridBoard.h"
+
+// Board sizes a game can be started with
+enum class BoardVariant {
+    Classic3x3,  // 3x3, 3 in a row (the bitboard Board used by the solved table)
+    Grid4x4,     // 4x4, 4 in a row
+    Grid5x5,     // 5x5, 4 in a row
+    Gomoku15x15  // 15x15, 5 in a row
+};
+
+// Runtime-selectable board: holds exactly one concrete board type and forwards to it.
+// The classic 3x3 game keeps using Board so the AI's tables still apply to it.
+class AnyBoard {
+public:
+    using Grid4x4 = GridBoard<4, 4>;
+    using Grid5x5 = GridBoard<5, 4>;
+    using Gomoku15x15 = GridBoard<15, 5>;
+
+    explicit AnyBoard(BoardVariant variant = BoardVariant::Classic3x3);
+
+    BoardVariant getVariant() const { return variant; }
+    int size() const;
+    int winLength() const;
+
+    void reset();
+    bool makeMove(int row, int col, int player);
+    void undoMove(int row, int col);
+    int getCell(int row, int col) const;
+    bool isFull() const;
+    int checkWin() const; // Returns PLAYER_X, PLAYER_O, or EMPTY for no win/draw
+    Board::Hash getHash() const;
+
+    // The classic board, or nullptr when a larger variant is in play
+    const Board* classic() const { return std::get_if<Board>(&board); }
+
+    // Calls visitor(concreteBoard) with the board's real type, for code templated on the board
+    template <typename Visitor>
+    decltype(auto) visit(Visitor&& visitor) { return std::visit(std::forward<Visitor>(visitor), board); }
+    template <typename Visitor>
+    decltype(auto) visit(Visitor&& visitor) const { return std::visit(std::forward<Visitor>(visitor), board); }
+
+private:
+    BoardVariant variant;
+    std::variant<Board, Grid4x4, Grid5x5, Gomoku15x15> board;
+};
+
+#endif // ANYBOARD_H
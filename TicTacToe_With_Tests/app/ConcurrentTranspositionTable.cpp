@@ -0,0 +1,56 @@
+#include "ConcurrentTranspositionTable.h"
+
+ConcurrentTranspositionTable::ConcurrentTranspositionTable(int sizeLog2)
+    : buckets(new Slot[std::size_t(1) << sizeLog2]),
+    indexMask((quint64(1) << sizeLog2) - 1)
+{
+}
+
+bool ConcurrentTranspositionTable::probe(Board::Hash key, Entry& entry) const {
+    const Slot& slot = buckets[key & indexMask];
+    const quint64 data = slot.data.load(std::memory_order_relaxed);
+    const quint64 check = slot.check.load(std::memory_order_relaxed);
+    if (data == 0 || (check ^ data) != key) {
+        return false; // Empty, another position, or a write in progress
+    }
+    entry = unpack(data);
+    return true;
+}
+
+void ConcurrentTranspositionTable::store(Board::Hash key, int score, int depth, int bestMove,
+                                         TranspositionTable::Bound bound) {
+    Slot& slot = buckets[key & indexMask];
+    // Keep a deeper result for the same position; anything else is replaced
+    const quint64 oldData = slot.data.load(std::memory_order_relaxed);
+    if (oldData != 0 && (slot.check.load(std::memory_order_relaxed) ^ oldData) == key &&
+        unpack(oldData).depth > depth) {
+        return;
+    }
+    const quint64 data = pack(score, depth, bestMove, bound);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+void ConcurrentTranspositionTable::clear() {
+    for (quint64 i = 0; i <= indexMask; ++i) {
+        buckets[i].check.store(0, std::memory_order_relaxed);
+        buckets[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Bits 0-31 score, 32-39 depth, 40-55 bestMove + 1, 56-63 bound
+quint64 ConcurrentTranspositionTable::pack(int score, int depth, int bestMove, TranspositionTable::Bound bound) {
+    return quint64(quint32(score)) |
+           (quint64(quint8(depth)) << 32) |
+           (quint64(quint16(bestMove + 1)) << 40) |
+           (quint64(bound) << 56);
+}
+
+ConcurrentTranspositionTable::Entry ConcurrentTranspositionTable::unpack(quint64 data) {
+    Entry entry;
+    entry.score = static_cast<qint32>(quint32(data));
+    entry.depth = static_cast<qint8>(quint8(data >> 32));
+    entry.bestMove = static_cast<qint16>(int(quint16(data >> 40)) - 1);
+    entry.bound = static_cast<TranspositionTable::Bound>(quint8(data >> 56));
+    return entry;
+}
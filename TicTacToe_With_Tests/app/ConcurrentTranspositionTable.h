@@ -0,0 +1,46 @@
+#ifndef CONCURRENTTRANSPOSITIONTABLE_H
+#define CONCURRENTTRANSPOSITIONTABLE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include "board.h"
+#include "TranspositionTable.h"
+
+// Transposition table that several search threads can read and write at once without locks.
+// Each slot stores the packed entry and (key XOR entry). A reader that sees a torn slot, with the
+// two words coming from different writes, gets a key mismatch and treats it as a miss.
+class ConcurrentTranspositionTable
+{
+public:
+    struct Entry {
+        qint32 score = 0;
+        qint8 depth = 0;     // Remaining depth the score was searched to
+        qint16 bestMove = -1; // Cell index (row * SIZE + col), -1 if none
+        TranspositionTable::Bound bound = TranspositionTable::NONE;
+    };
+
+    explicit ConcurrentTranspositionTable(int sizeLog2 = 18);
+
+    // Copies the entry for this key into entry; false if the slot holds nothing usable
+    bool probe(Board::Hash key, Entry& entry) const;
+    void store(Board::Hash key, int score, int depth, int bestMove, TranspositionTable::Bound bound);
+    // Not safe while a search is using the table
+    void clear();
+
+    int size() const { return static_cast<int>(indexMask + 1); }
+
+private:
+    struct Slot {
+        std::atomic<quint64> check{0}; // key ^ data
+        std::atomic<quint64> data{0};  // Packed Entry; 0 is an empty slot (bound NONE)
+    };
+
+    static quint64 pack(int score, int depth, int bestMove, TranspositionTable::Bound bound);
+    static Entry unpack(quint64 data);
+
+    std::unique_ptr<Slot[]> buckets; // Allocated once; size is a power of two
+    quint64 indexMask;
+};
+
+#endif // CONCURRENTTRANSPOSITIONTABLE_H
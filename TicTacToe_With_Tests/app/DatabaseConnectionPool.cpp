@@ -0,0 +1,79 @@
+#include "DatabaseConnectionPool.h"
+#include <QDebug>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+
+namespace {
+
+// Per-connection settings; journal_mode is stored in the file, the others last as long as the connection
+const char* const PRAGMAS[] = {
+    "PRAGMA journal_mode = WAL",
+    "PRAGMA synchronous = NORMAL",   // Sync at checkpoints rather than on every commit (safe in WAL mode)
+    "PRAGMA cache_size = -16384",    // 16 MB page cache (negative values are KiB)
+    "PRAGMA mmap_size = 268435456",  // Read up to 256 MB of the file through a memory map instead of read()
+    "PRAGMA temp_store = MEMORY"     // Sorts and temporary indexes stay off disk
+};
+
+QMutex poolMutex;
+QHash<QString, int> references; // Connection name -> DatabaseManagers using it
+
+QString connectionName(const QString &databaseFile) {
+    return QString("%1@thread%2").arg(databaseFile).arg(reinterpret_cast<quintptr>(QThread::currentThread()));
+}
+
+void configure(QSqlDatabase &connection) {
+    QSqlQuery pragma(connection);
+    for (const char* statement : PRAGMAS) {
+        if (!pragma.exec(statement)) {
+            qDebug() << "Failed to apply" << statement << ":" << pragma.lastError().text();
+        }
+    }
+}
+}
+
+namespace DatabaseConnectionPool {
+
+QSqlDatabase acquire(const QString &databaseFile) {
+    const QString name = connectionName(databaseFile);
+    QMutexLocker locker(&poolMutex);
+    if (references.contains(name)) {
+        ++references[name];
+        return QSqlDatabase::database(name, false);
+    }
+
+    QSqlDatabase connection = QSqlDatabase::addDatabase("QSQLITE", name);
+    connection.setDatabaseName(databaseFile);
+    connection.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000"); // A second writer waits for the lock instead of failing
+    if (connection.open()) {
+        configure(connection);
+    } else {
+        qDebug() << "Error: connection with database failed:" << connection.lastError().text();
+    }
+    references.insert(name, 1);
+    return connection;
+}
+
+void release(QSqlDatabase &connection) {
+    const QString name = connection.connectionName();
+    connection = QSqlDatabase(); // removeDatabase() needs every handle to the connection gone
+    QMutexLocker locker(&poolMutex);
+    auto it = references.find(name);
+    if (it == references.end()) {
+        return;
+    }
+    if (--it.value() > 0) {
+        return;
+    }
+    references.erase(it);
+    QSqlDatabase::removeDatabase(name); // Closes it
+}
+
+int connectionCount() {
+    QMutexLocker locker(&poolMutex);
+    return references.size();
+}
+}
@@ -0,0 +1,25 @@
+#ifndef DATABASECONNECTIONPOOL_H
+#define DATABASECONNECTIONPOOL_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// One named SQLite connection per (database file, thread). A QSqlDatabase may only be used from the thread
+// that opened it, so every thread gets its own, shared by all DatabaseManagers on that thread and closed when
+// the last of them releases it.
+// Connections are opened in WAL mode: readers work from a snapshot and never block the writer, and a commit
+// only appends to the log. With synchronous=NORMAL a commit is not synced to disk until the next checkpoint,
+// so a power cut can lose the last few games but never corrupts the database.
+namespace DatabaseConnectionPool {
+
+// The calling thread's open connection to databaseFile (check isOpen(); opening can fail)
+QSqlDatabase acquire(const QString &databaseFile);
+
+// Gives back a connection from acquire() on the same thread; clears `connection`
+void release(QSqlDatabase &connection);
+
+// Connections currently held, over all threads
+int connectionCount();
+}
+
+#endif // DATABASECONNECTIONPOOL_H
@@ -1,55 +1,36 @@
 #include "DatabaseManager.h"
+#include "DatabaseConnectionPool.h"
 #include <QDateTime> // For QDateTime, used for timestamp handling
 #include <QDebug>    // For qDebug() for logging and error messages
+#include <QHash>
 
 // Default constructor - uses "users.db"
-DatabaseManager::DatabaseManager(QObject *parent) : QObject(parent)
+DatabaseManager::DatabaseManager(QObject *parent) : DatabaseManager(parent, "users.db")
 {
-    // Check if the default connection exists, if so, use it, otherwise add it.
-    // This handles cases where a connection might already be established
-    // (e.g., from a previous DatabaseManager instance if not properly removed).
-    if (QSqlDatabase::contains()) { // Checks if the default connection ("qt_sql_default_connection") exists
-        db = QSqlDatabase::database();
-    } else {
-        db = QSqlDatabase::addDatabase("QSQLITE"); // Add a new SQLite database connection
-    }
-    db.setDatabaseName("users.db"); // Set the default database file name
-    initializeDatabase(); // Initialize tables if they don't exist
 }
 
-// NEW Constructor for testing - accepts a specific database file name
+// Constructor for a specific database file (useful for testing)
 DatabaseManager::DatabaseManager(QObject *parent, const QString& dbFileName) : QObject(parent)
 {
-    // For testing, it's often good practice to use a unique connection name
-    // to avoid conflicts with the default application connection.
-    // However, for simplicity and alignment with existing test structure,
-    // we'll still use the default connection name if one isn't specified directly.
-    // The key here is overriding the `setDatabaseName` to the test file.
-
-    if (QSqlDatabase::contains()) { // Check for the default connection
-        db = QSqlDatabase::database();
-    } else {
-        db = QSqlDatabase::addDatabase("QSQLITE"); // Add a new default connection
-    }
-    db.setDatabaseName(dbFileName); // Set the provided database file name for this instance
+    // This thread's connection to the file, shared with other DatabaseManagers on the same thread; a manager
+    // created on another thread (e.g. GameHistoryWriter's) gets a connection of its own
+    db = DatabaseConnectionPool::acquire(dbFileName);
     initializeDatabase(); // Initialize tables if they don't exist
 }
 
 DatabaseManager::~DatabaseManager()
 {
-    if (db.isOpen()) {
-        db.close(); // Close the database connection when the object is destroyed
-    }
-    // Do NOT call QSqlDatabase::removeDatabase() here in the application's destructor.
-    // Removing connections explicitly in application code should be done with care,
-    // as it can affect other parts of the application if they rely on the same connection.
-    // For tests, `init()` and `cleanupTestCase()` in tst_databasemanager.cpp handle removal.
+    clearStatements(); // Finalize the cached statements before their connection goes away
+    DatabaseConnectionPool::release(db); // Closed once no other manager on this thread uses it
 }
 
 bool DatabaseManager::initializeDatabase() {
-    if (!db.open()) {
-        qDebug() << "Error: connection with database failed:" << db.lastError().text();
-        return false;
+    if (!db.isOpen()) {
+        clearStatements(); // Opening the connection finalizes every statement prepared on it
+        if (!db.open()) {
+            qDebug() << "Error: connection with database failed:" << db.lastError().text();
+            return false;
+        }
     }
 
     QSqlQuery query(db); // Create a QSqlQuery object associated with this database connection
@@ -71,23 +52,387 @@ bool DatabaseManager::initializeDatabase() {
                          "player1 TEXT NOT NULL,"
                          "player2 TEXT NOT NULL,"
                          "result TEXT NOT NULL," // Stores game result (e.g., "Player X Wins!", "Draw")
-                         "moves TEXT NOT NULL,"   // Stores a comma-separated string of moves
+                         "outcome INTEGER NOT NULL DEFAULT 0," // The result as a GameOutcome
+                         "ai_difficulty TEXT," // Difficulty of an "AI" player2; NULL otherwise, and for older games
+                         "moves BLOB NOT NULL,"   // Stores the moves as encoded by encodeMoves()
                          "timestamp DATETIME DEFAULT CURRENT_TIMESTAMP)"); // Automatically records insertion time
     if (!success) {
         qDebug() << "Error creating game_history table:" << query.lastError().text();
         return false;
     }
+
+    // One index per player column, each already in history order, so a user's history is two index range
+    // scans merged together instead of a full table scan and a sort
+    for (const char* index : {"CREATE INDEX IF NOT EXISTS game_history_player1 ON game_history (player1, timestamp, id)",
+                              "CREATE INDEX IF NOT EXISTS game_history_player2 ON game_history (player2, timestamp, id)"}) {
+        if (!query.exec(index)) {
+            qDebug() << "Error creating game_history index:" << query.lastError().text();
+            return false;
+        }
+    }
+    return migrateTextMoves() && migrateOutcomes() && migrateAiDifficulty() && createUserStats() && createRatings();
+}
+
+bool DatabaseManager::migrateAiDifficulty() {
+    QSqlQuery query(db);
+    if (!query.exec("SELECT 1 FROM pragma_table_info('game_history') WHERE name = 'ai_difficulty'")) {
+        qDebug() << "Failed to inspect game_history:" << query.lastError().text();
+        return false;
+    }
+    if (query.next()) {
+        return true; // Already there
+    }
+    query.finish();
+    if (!query.exec("ALTER TABLE game_history ADD COLUMN ai_difficulty TEXT")) {
+        qDebug() << "Failed to add the ai_difficulty column:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::migrateOutcomes() {
+    QSqlQuery query(db);
+    if (!query.exec("SELECT 1 FROM pragma_table_info('game_history') WHERE name = 'outcome'")) {
+        qDebug() << "Failed to inspect game_history:" << query.lastError().text();
+        return false;
+    }
+    if (query.next()) {
+        return true; // Already there
+    }
+    query.finish();
+
+    // Filled per distinct result text, so outcomeFromResult() stays the only place results are interpreted
+    QStringList results;
+    if (!query.exec("SELECT DISTINCT result FROM game_history")) {
+        qDebug() << "Failed to read game results:" << query.lastError().text();
+        return false;
+    }
+    while (query.next()) {
+        results.append(query.value(0).toString());
+    }
+
+    db.transaction();
+    if (!query.exec("ALTER TABLE game_history ADD COLUMN outcome INTEGER NOT NULL DEFAULT 0")) {
+        qDebug() << "Failed to add the outcome column:" << query.lastError().text();
+        db.rollback();
+        return false;
+    }
+    QSqlQuery update(db);
+    update.prepare("UPDATE game_history SET outcome = :o WHERE result = :r");
+    for (const QString &result : results) {
+        update.bindValue(":o", static_cast<int>(outcomeFromResult(result)));
+        update.bindValue(":r", result);
+        if (!update.exec()) {
+            qDebug() << "Failed to fill in outcomes:" << update.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
+
+namespace {
+// user_stats follows game_history through triggers, so every way of saving or deleting a game (including a
+// batch, or SQL run against the connection directly) updates it in the same transaction. Each player counts
+// the game from their own side; a game against oneself counts once, for player1.
+const char* const USER_STATS_SCHEMA[] = {
+    "CREATE TABLE user_stats ("
+    "username TEXT PRIMARY KEY,"
+    "games INTEGER NOT NULL DEFAULT 0,"
+    "wins INTEGER NOT NULL DEFAULT 0,"
+    "losses INTEGER NOT NULL DEFAULT 0,"
+    "draws INTEGER NOT NULL DEFAULT 0)",
+
+    "CREATE TRIGGER user_stats_after_insert AFTER INSERT ON game_history BEGIN "
+    "INSERT INTO user_stats (username, games, wins, losses, draws) "
+    "VALUES (NEW.player1, 1, NEW.outcome = 1, NEW.outcome = 2, NEW.outcome = 3) "
+    "ON CONFLICT (username) DO UPDATE SET games = games + 1, wins = wins + excluded.wins, "
+    "losses = losses + excluded.losses, draws = draws + excluded.draws; "
+    "INSERT INTO user_stats (username, games, wins, losses, draws) "
+    "SELECT NEW.player2, 1, NEW.outcome = 2, NEW.outcome = 1, NEW.outcome = 3 WHERE NEW.player2 <> NEW.player1 "
+    "ON CONFLICT (username) DO UPDATE SET games = games + 1, wins = wins + excluded.wins, "
+    "losses = losses + excluded.losses, draws = draws + excluded.draws; "
+    "END",
+
+    "CREATE TRIGGER user_stats_after_delete AFTER DELETE ON game_history BEGIN "
+    "UPDATE user_stats SET games = games - 1, wins = wins - (OLD.outcome = 1), "
+    "losses = losses - (OLD.outcome = 2), draws = draws - (OLD.outcome = 3) WHERE username = OLD.player1; "
+    "UPDATE user_stats SET games = games - 1, wins = wins - (OLD.outcome = 2), "
+    "losses = losses - (OLD.outcome = 1), draws = draws - (OLD.outcome = 3) "
+    "WHERE username = OLD.player2 AND OLD.player2 <> OLD.player1; "
+    "END",
+
+    // Games stored before user_stats existed; the only time the whole history is aggregated
+    "INSERT INTO user_stats (username, games, wins, losses, draws) "
+    "SELECT username, COUNT(*), SUM(outcome = 1), SUM(outcome = 2), SUM(outcome = 3) FROM ("
+    "SELECT player1 AS username, outcome FROM game_history "
+    "UNION ALL "
+    "SELECT player2, CASE outcome WHEN 1 THEN 2 WHEN 2 THEN 1 ELSE outcome END FROM game_history WHERE player2 <> player1"
+    ") GROUP BY username"
+};
+}
+
+bool DatabaseManager::createRatings() {
+    QSqlQuery query(db);
+    if (!query.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'ratings'")) {
+        qDebug() << "Failed to look for ratings:" << query.lastError().text();
+        return false;
+    }
+    if (query.next()) {
+        return true;
+    }
+    query.finish();
+
+    // Table, index and ratings appear together, or not at all: a failed replay must not leave an empty table
+    // that later startups would take as already filled. IMMEDIATE, as in recomputeRatings(), so no game is saved
+    // between the replay and the commit; harmless if another thread got here too.
+    if (!query.exec("BEGIN IMMEDIATE")) {
+        qDebug() << "Failed to start creating ratings:" << query.lastError().text();
+        return false;
+    }
+    // The index is in leaderboard order, so topRatings() reads its first rows instead of sorting every player
+    if (!query.exec("CREATE TABLE IF NOT EXISTS ratings (player TEXT PRIMARY KEY, rating REAL NOT NULL, games INTEGER NOT NULL)")
+        || !query.exec("CREATE INDEX IF NOT EXISTS ratings_by_rating ON ratings (rating DESC, player)")) {
+        qDebug() << "Error creating ratings:" << query.lastError().text();
+        query.exec("ROLLBACK");
+        return false;
+    }
+    if (!replayRatings() || !query.exec("COMMIT")) { // Rates the games stored before ratings existed
+        qDebug() << "Failed to fill in ratings:" << query.lastError().text();
+        query.exec("ROLLBACK");
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::createUserStats() {
+    QSqlQuery query(db);
+    if (!query.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'user_stats'")) {
+        qDebug() << "Failed to look for user_stats:" << query.lastError().text();
+        return false;
+    }
+    if (query.next()) {
+        return true;
+    }
+    query.finish();
+
+    db.transaction(); // Table, triggers and totals appear together, or not at all
+    for (const char* statement : USER_STATS_SCHEMA) {
+        if (!query.exec(statement)) {
+            qDebug() << "Error creating user_stats:" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
+
+bool DatabaseManager::migrateTextMoves() {
+    // Databases created before the BLOB format keep their TEXT column; SQLite stores a bound BLOB as is, so only
+    // the rows themselves need converting. Once they are, this finds nothing.
+    QSqlQuery select(db);
+    if (!select.exec("SELECT id, moves FROM game_history WHERE typeof(moves) = 'text'")) {
+        qDebug() << "Failed to look for text move lists:" << select.lastError().text();
+        return false;
+    }
+    QList<QPair<int, QByteArray>> converted;
+    while (select.next()) {
+        GameRecord moves;
+        if (!parseTextMoves(select.value(1).toString(), moves)) {
+            qDebug() << "Leaving unreadable moves of game" << select.value(0).toInt() << "as text";
+            continue;
+        }
+        converted.append(qMakePair(select.value(0).toInt(), encodeMoves(moves)));
+    }
+    if (converted.isEmpty()) {
+        return true;
+    }
+
+    db.transaction(); // One commit for the whole table instead of one per row
+    QSqlQuery update(db);
+    update.prepare("UPDATE game_history SET moves = :m WHERE id = :id");
+    for (const QPair<int, QByteArray>& row : converted) {
+        update.bindValue(":m", row.second);
+        update.bindValue(":id", row.first);
+        if (!update.exec()) {
+            qDebug() << "Failed to convert moves of game" << row.first << ":" << update.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
+
+QByteArray DatabaseManager::encodeMoves(const GameRecord &moves) {
+    QByteArray bytes;
+    bytes.reserve(1 + static_cast<int>(moves.size()));
+    bytes.append(static_cast<char>(moves.getVariant()));
+    bytes.append(reinterpret_cast<const char*>(moves.data()), static_cast<int>(moves.size()));
+    return bytes;
+}
+
+bool DatabaseManager::decodeMoves(const QByteArray &bytes, GameRecord &moves) {
+    if (bytes.isEmpty() || bytes.size() - 1 > GameRecord::MAX_MOVES) {
+        return false;
+    }
+    const int variant = static_cast<unsigned char>(bytes[0]);
+    if (variant > static_cast<int>(BoardVariant::Gomoku15x15)) {
+        return false;
+    }
+    moves.reset(static_cast<BoardVariant>(variant));
+    for (int i = 1; i < bytes.size(); ++i) {
+        if (!moves.appendCell(static_cast<unsigned char>(bytes[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DatabaseManager::parseTextMoves(const QString &text, BoardVariant variant, GameRecord &moves) {
+    const QStringList entries = text.isEmpty() ? QStringList() : text.split(",");
+    if (entries.size() > GameRecord::MAX_MOVES) {
+        return false;
+    }
+    const int size = GameRecord::sizeOf(variant);
+    moves.reset(variant);
+    for (const QString &entry : entries) {
+        const QStringList parts = entry.split(":");
+        bool rowOk = false;
+        bool colOk = false;
+        if (parts.size() != 3) {
+            return false;
+        }
+        const int row = parts[0].toInt(&rowOk);
+        const int col = parts[1].toInt(&colOk);
+        if (!rowOk || !colOk || row < 0 || col < 0 || row >= size || col >= size) {
+            return false;
+        }
+        moves.append(row, col);
+    }
     return true;
 }
 
+bool DatabaseManager::parseTextMoves(const QString &text, GameRecord &moves) {
+    // Read on the largest board first, then again on the smallest one that holds every coordinate
+    GameRecord widest;
+    if (!parseTextMoves(text, BoardVariant::Gomoku15x15, widest)) {
+        return false;
+    }
+    const int widestSize = GameRecord::sizeOf(BoardVariant::Gomoku15x15);
+    int largest = 0;
+    for (std::size_t i = 0; i < widest.size(); ++i) {
+        largest = qMax(largest, qMax(widest.cell(i) / widestSize, widest.cell(i) % widestSize));
+    }
+    BoardVariant variant = BoardVariant::Gomoku15x15;
+    for (BoardVariant candidate : {BoardVariant::Grid5x5, BoardVariant::Grid4x4, BoardVariant::Classic3x3}) {
+        if (largest < GameRecord::sizeOf(candidate)) {
+            variant = candidate;
+        }
+    }
+    return parseTextMoves(text, variant, moves);
+}
+
+QString DatabaseManager::movesToText(const GameRecord &moves) {
+    QStringList entries;
+    entries.reserve(static_cast<int>(moves.size()));
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        const MoveRecord move = moves[i];
+        entries.append(QString("%1:%2:%3").arg(move.row).arg(move.col).arg((move.player == Board::PLAYER_X) ? 'X' : 'O'));
+    }
+    return entries.join(",");
+}
+
+GameOutcome DatabaseManager::outcomeFromResult(const QString &result) {
+    // player1 is always the logged-in user playing X; player2 is "AI" or "Player O"
+    if (result == "Player X wins!") {
+        return GameOutcome::Player1Won;
+    }
+    if (result == "AI wins!" || result == "Player O wins!") {
+        return GameOutcome::Player2Won;
+    }
+    if (result == "Draw") {
+        return GameOutcome::Draw;
+    }
+    return GameOutcome::Unknown;
+}
+
+GameRecord DatabaseManager::movesFromColumn(const QVariant &value) {
+    GameRecord moves;
+    // Rows that could not be migrated are still text
+    const bool ok = value.userType() == QMetaType::QByteArray ? decodeMoves(value.toByteArray(), moves)
+                                                             : parseTextMoves(value.toString(), moves);
+    if (!ok) {
+        moves.clear();
+    }
+    return moves;
+}
+
+namespace {
+// SQL for each DatabaseManager::Statement, in enum order
+const char* const STATEMENT_SQL[] = {
+    "INSERT INTO users (username, password, firstName, lastName) VALUES (:u, :p, :f, :l)",
+    "SELECT * FROM users WHERE username = :u AND password = :p",
+    "UPDATE users SET password = :password WHERE username = :username",
+    "INSERT INTO game_history (player1, player2, result, outcome, moves, ai_difficulty) VALUES (:p1, :p2, :r, :o, :m, :d)",
+    // Games as player1, then games as player2 only (so a game against oneself is listed once). Both halves come
+    // out of their index in (timestamp, id) order, which lets SQLite merge them instead of sorting; the OR form
+    // of this query scans the whole table. 'id DESC' keeps games saved within the same second in a
+    // deterministic order.
+    "SELECT id, player1, player2, result, timestamp, moves FROM game_history WHERE player1 = :currentUser "
+    "UNION ALL "
+    "SELECT id, player1, player2, result, timestamp, moves FROM game_history WHERE player2 = :currentUser AND player1 <> :currentUser "
+    "ORDER BY timestamp DESC, id DESC",
+    // The same merge, resuming below the last game of the previous page. The first page passes a timestamp
+    // later than any stored one; it has to look like a date, as a bare number would sort before all text.
+    "SELECT id, player1, player2, result, timestamp FROM game_history "
+    "WHERE player1 = :currentUser AND (timestamp, id) < (:afterTimestamp, :afterId) "
+    "UNION ALL "
+    "SELECT id, player1, player2, result, timestamp FROM game_history "
+    "WHERE player2 = :currentUser AND player1 <> :currentUser AND (timestamp, id) < (:afterTimestamp, :afterId) "
+    "ORDER BY timestamp DESC, id DESC LIMIT :limit",
+    "DELETE FROM game_history WHERE id = :gameId",
+    "SELECT firstName, lastName, username FROM users WHERE username = :username",
+    "SELECT moves FROM game_history WHERE id = :gameId",
+    "SELECT games, wins, losses, draws FROM user_stats WHERE username = :username",
+    "SELECT rating, games FROM ratings WHERE player = :player",
+    "INSERT INTO ratings (player, rating, games) VALUES (:player, :rating, :games) "
+    "ON CONFLICT (player) DO UPDATE SET rating = excluded.rating, games = excluded.games",
+    "SELECT player, rating, games FROM ratings ORDER BY rating DESC, player LIMIT :count"
+};
+}
+
+QSqlQuery &DatabaseManager::statement(Statement id) {
+    static_assert(sizeof(STATEMENT_SQL) / sizeof(STATEMENT_SQL[0]) == StatementCount, "one SQL string per Statement");
+    CachedStatement &cached = statements[id];
+    if (cached.prepared) {
+        ++statementHits;
+        return *cached.query; // Parsed and planned already; callers only rebind the values
+    }
+    cached.query.emplace(db);
+    cached.query->setForwardOnly(true); // Results are read once, front to back
+    cached.prepared = cached.query->prepare(STATEMENT_SQL[id]);
+    ++statementPreparations;
+    if (!cached.prepared) {
+        // Left unprepared so the next call tries again; exec() on it fails and the caller reports that
+        qDebug() << "Failed to prepare statement:" << cached.query->lastError().text();
+    }
+    return *cached.query;
+}
+
+void DatabaseManager::clearStatements() {
+    for (CachedStatement &cached : statements) {
+        cached.query.reset();
+        cached.prepared = false;
+    }
+}
+
 bool DatabaseManager::registerUser(const QString &username, const QString &password, const QString &firstName, const QString &lastName) {
     if (!db.isOpen()) {
         qDebug() << "Database not open.";
         return false;
     }
 
-    QSqlQuery query(db); // Associate query with the current database connection
-    query.prepare("INSERT INTO users (username, password, firstName, lastName) VALUES (:u, :p, :f, :l)");
+    QSqlQuery &query = statement(RegisterUserStatement);
     query.bindValue(":u", username);
     query.bindValue(":p", QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex()); // Hash password
     query.bindValue(":f", firstName);
@@ -100,18 +445,24 @@ bool DatabaseManager::registerUser(const QString &username, const QString &passw
     return true;
 }
 
+bool DatabaseManager::registerUser(const QString &username, const QString &password, const QString &email, const QString &firstName, const QString &lastName) {
+    Q_UNUSED(email);
+    return registerUser(username, password, firstName, lastName);
+}
+
 bool DatabaseManager::authenticateUser(const QString &username, const QString &password) {
     if (!db.isOpen()) {
         qDebug() << "Database not open.";
         return false;
     }
 
-    QSqlQuery query(db); // Associate query with the current database connection
-    query.prepare("SELECT * FROM users WHERE username = :u AND password = :p");
+    QSqlQuery &query = statement(AuthenticateUserStatement);
     query.bindValue(":u", username);
     query.bindValue(":p", QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex()); // Hash input password for comparison
 
-    if (query.exec() && query.next()) { // Execute query and check if any record was found
+    const bool found = query.exec() && query.next(); // Execute query and check if any record was found
+    query.finish(); // Release the statement for the next call
+    if (found) {
         return true; // User found and password matches
     }
     qDebug() << "Authentication failed for user:" << username;
@@ -124,8 +475,7 @@ bool DatabaseManager::resetUserPassword(const QString &username, const QString &
         return false;
     }
 
-    QSqlQuery query(db); // Associate query with the current database connection
-    query.prepare("UPDATE users SET password = :password WHERE username = :username");
+    QSqlQuery &query = statement(ResetPasswordStatement);
     query.bindValue(":password", QCryptographicHash::hash(newPassword.toUtf8(), QCryptographicHash::Sha256).toHex()); // Hash new password
     query.bindValue(":username", username);
 
@@ -137,24 +487,52 @@ bool DatabaseManager::resetUserPassword(const QString &username, const QString &
     return true; // Password reset successful
 }
 
-bool DatabaseManager::saveGameHistory(const QString &player1, const QString &player2, const QString &result, const QStringList &moves) {
+bool DatabaseManager::saveGameHistory(const QString &player1, const QString &player2, const QString &result,
+                                      const QStringList &moves, BoardVariant variant) {
+    GameRecord record;
+    if (!parseTextMoves(moves.join(","), variant, record)) {
+        qDebug() << "Failed to save game history: unreadable moves" << moves;
+        return false;
+    }
+    return saveGameHistory(player1, player2, result, record);
+}
+
+bool DatabaseManager::saveGameHistory(const QString &player1, const QString &player2, const QString &result, const GameRecord &moves) {
+    // The game and its rating update are committed together
+    return saveGameHistoryBatch({FinishedGame{player1, player2, result, moves}});
+}
+
+bool DatabaseManager::saveGameHistoryBatch(const QVector<FinishedGame> &games) {
     if (!db.isOpen()) {
         qDebug() << "Database not open.";
         return false;
     }
+    if (!db.transaction()) {
+        qDebug() << "Failed to start game history batch:" << db.lastError().text();
+        return false;
+    }
 
-    QSqlQuery query(db); // Associate query with the current database connection
-    query.prepare("INSERT INTO game_history (player1, player2, result, moves) VALUES (:p1, :p2, :r, :m)");
-    query.bindValue(":p1", player1);
-    query.bindValue(":p2", player2);
-    query.bindValue(":r", result);
-    query.bindValue(":m", moves.join(",")); // Join QStringList into a single comma-separated string
-
-    if (!query.exec()) {
-        qDebug() << "Failed to save game history:" << query.lastError().text();
+    for (const FinishedGame &game : games) {
+        const GameOutcome outcome = outcomeFromResult(game.result);
+        QSqlQuery &query = statement(SaveGameStatement);
+        query.bindValue(":p1", game.player1);
+        query.bindValue(":p2", game.player2);
+        query.bindValue(":r", game.result);
+        query.bindValue(":o", static_cast<int>(outcome));
+        query.bindValue(":m", encodeMoves(game.moves)); // Bound as a BLOB
+        query.bindValue(":d", game.aiDifficulty.isEmpty() ? QVariant() : QVariant(game.aiDifficulty));
+        if (!query.exec() || !rateGame(game.player1, ratedPlayer(game.player2, game.aiDifficulty), outcome)) {
+            qDebug() << "Failed to save game history batch:" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    if (!db.commit()) {
+        qDebug() << "Failed to commit game history batch:" << db.lastError().text();
+        db.rollback();
         return false;
     }
-    return true; // Game history saved successfully
+    return true;
 }
 
 QList<QVariantMap> DatabaseManager::loadGameHistory(const QString &username) {
@@ -164,9 +542,7 @@ QList<QVariantMap> DatabaseManager::loadGameHistory(const QString &username) {
         return historyList;
     }
 
-    QSqlQuery query(db); // Associate query with the current database connection
-    // MODIFIED: Added 'id DESC' to the ORDER BY clause for deterministic sorting
-    query.prepare("SELECT id, player1, player2, result, timestamp, moves FROM game_history WHERE player1 = :currentUser OR player2 = :currentUser ORDER BY timestamp DESC, id DESC");
+    QSqlQuery &query = statement(LoadHistoryStatement);
     query.bindValue(":currentUser", username); // Bind current username for filtering history
 
     if (query.exec()) {
@@ -177,12 +553,13 @@ QList<QVariantMap> DatabaseManager::loadGameHistory(const QString &username) {
             item["player2"] = query.value("player2").toString();
             item["result"] = query.value("result").toString();
             item["timestamp"] = query.value("timestamp").toDateTime();
-            item["moves"] = query.value("moves").toString();
+            item["moves"] = movesToText(movesFromColumn(query.value("moves")));
             historyList.append(item); // Add item to the list
         }
     } else {
         qDebug() << "Failed to load game history:" << query.lastError().text();
     }
+    query.finish(); // Release the statement for the next call
     return historyList;
 }
 
@@ -192,8 +569,7 @@ bool DatabaseManager::deleteGameHistory(int gameId) {
         return false;
     }
 
-    QSqlQuery query(db); // Associate query with the current database connection
-    query.prepare("DELETE FROM game_history WHERE id = :gameId");
+    QSqlQuery &query = statement(DeleteGameStatement);
     query.bindValue(":gameId", gameId); // Bind the ID of the game to delete
 
     if (!query.exec()) {
@@ -203,6 +579,235 @@ bool DatabaseManager::deleteGameHistory(int gameId) {
     return true; // Game history deleted successfully
 }
 
+QVector<GameHistoryEntry> DatabaseManager::loadGameHistoryPage(const QString &username, int limit, const GameHistoryEntry *after) {
+    QVector<GameHistoryEntry> page;
+    if (!db.isOpen()) {
+        qDebug() << "Database not open.";
+        return page;
+    }
+
+    QSqlQuery &query = statement(LoadHistoryPageStatement);
+    query.bindValue(":currentUser", username);
+    // Bound as stored text: a QDateTime would be bound in ISO form ('T' separator), which compares differently
+    query.bindValue(":afterTimestamp", after ? after->timestamp : QString("9999-12-31 23:59:59"));
+    query.bindValue(":afterId", after ? after->id : 0);
+    query.bindValue(":limit", limit);
+
+    if (query.exec()) {
+        page.reserve(limit);
+        while (query.next()) {
+            GameHistoryEntry entry;
+            entry.id = query.value("id").toInt();
+            entry.player1 = query.value("player1").toString();
+            entry.player2 = query.value("player2").toString();
+            entry.result = query.value("result").toString();
+            entry.timestamp = query.value("timestamp").toString();
+            entry.playedAt = query.value("timestamp").toDateTime();
+            page.append(entry);
+        }
+    } else {
+        qDebug() << "Failed to load game history page:" << query.lastError().text();
+    }
+    query.finish();
+    return page;
+}
+
+QStringList DatabaseManager::explain(Statement id, const QVariantMap &bindings) {
+    QStringList plan;
+    if (!db.isOpen()) {
+        qDebug() << "Database not open.";
+        return plan;
+    }
+
+    QSqlQuery query(db);
+    query.prepare(QString("EXPLAIN QUERY PLAN ") + STATEMENT_SQL[id]);
+    for (auto it = bindings.constBegin(); it != bindings.constEnd(); ++it) {
+        query.bindValue(it.key(), it.value());
+    }
+    if (!query.exec()) {
+        qDebug() << "Failed to explain a query:" << query.lastError().text();
+        return plan;
+    }
+    while (query.next()) {
+        plan.append(query.value("detail").toString()); // Columns are id, parent, notused, detail
+    }
+    return plan;
+}
+
+QStringList DatabaseManager::explainHistoryQuery(const QString &username) {
+    QVariantMap bindings;
+    bindings[":currentUser"] = username;
+    return explain(LoadHistoryStatement, bindings);
+}
+
+QStringList DatabaseManager::explainLeaderboardQuery(int count) {
+    QVariantMap bindings;
+    bindings[":count"] = count;
+    return explain(TopRatingsStatement, bindings);
+}
+
+namespace {
+// Applies one game to both players' ratings; false if it does not count towards ratings
+bool rate(PlayerRating &player1, PlayerRating &player2, GameOutcome outcome) {
+    if (outcome == GameOutcome::Unknown || player1.player == player2.player) {
+        return false;
+    }
+    const double score = outcome == GameOutcome::Player1Won ? 1.0 : outcome == GameOutcome::Player2Won ? 0.0 : 0.5;
+    EloRating::update(player1.rating, player2.rating, score);
+    ++player1.games;
+    ++player2.games;
+    return true;
+}
+}
+
+QString DatabaseManager::aiPlayerName(const QString& difficulty) {
+    return difficulty.isEmpty() ? QString("AI") : QString("AI (%1)").arg(difficulty);
+}
+
+QString DatabaseManager::ratedPlayer(const QString& player2, const QString& aiDifficulty) {
+    return aiDifficulty.isEmpty() ? player2 : aiPlayerName(aiDifficulty);
+}
+
+bool DatabaseManager::readRating(const QString &player, PlayerRating &rating) {
+    QSqlQuery &query = statement(GetRatingStatement);
+    query.bindValue(":player", player);
+    if (!query.exec()) {
+        qDebug() << "Failed to read rating:" << query.lastError().text();
+        return false;
+    }
+    rating = PlayerRating();
+    rating.player = player;
+    if (query.next()) { // No row until the player's first rated game
+        rating.rating = query.value("rating").toDouble();
+        rating.games = query.value("games").toInt();
+    }
+    query.finish();
+    return true;
+}
+
+bool DatabaseManager::saveRating(const PlayerRating &rating) {
+    QSqlQuery &query = statement(SaveRatingStatement);
+    query.bindValue(":player", rating.player);
+    query.bindValue(":rating", rating.rating);
+    query.bindValue(":games", rating.games);
+    if (!query.exec()) {
+        qDebug() << "Failed to save rating:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::rateGame(const QString &player1, const QString &player2, GameOutcome outcome) {
+    if (outcome == GameOutcome::Unknown || player1 == player2) {
+        return true; // Nothing to rate, so nothing to read
+    }
+    PlayerRating first;
+    PlayerRating second;
+    if (!readRating(player1, first) || !readRating(player2, second)) {
+        return false;
+    }
+    rate(first, second, outcome);
+    return saveRating(first) && saveRating(second);
+}
+
+PlayerRating DatabaseManager::getRating(const QString& player) {
+    PlayerRating rating;
+    rating.player = player;
+    if (!db.isOpen()) {
+        qDebug() << "Database not open.";
+        return rating;
+    }
+    readRating(player, rating);
+    return rating;
+}
+
+QVector<PlayerRating> DatabaseManager::topRatings(int count) {
+    QVector<PlayerRating> leaders;
+    if (!db.isOpen()) {
+        qDebug() << "Database not open.";
+        return leaders;
+    }
+
+    QSqlQuery &query = statement(TopRatingsStatement);
+    query.bindValue(":count", count);
+    if (query.exec()) {
+        while (query.next()) {
+            PlayerRating rating;
+            rating.player = query.value("player").toString();
+            rating.rating = query.value("rating").toDouble();
+            rating.games = query.value("games").toInt();
+            leaders.append(rating);
+        }
+    } else {
+        qDebug() << "Failed to load the leaderboard:" << query.lastError().text();
+    }
+    query.finish();
+    return leaders;
+}
+
+bool DatabaseManager::recomputeRatings() {
+    if (!db.isOpen()) {
+        qDebug() << "Database not open.";
+        return false;
+    }
+
+    // IMMEDIATE takes the write lock before reading, so no game can be saved (and rated) between the replay
+    // and the rewrite; other writers wait for the busy timeout
+    QSqlQuery transaction(db);
+    if (!transaction.exec("BEGIN IMMEDIATE")) {
+        qDebug() << "Failed to start rating recompute:" << transaction.lastError().text();
+        return false;
+    }
+    if (!replayRatings()) {
+        transaction.exec("ROLLBACK");
+        return false;
+    }
+    if (!transaction.exec("COMMIT")) {
+        qDebug() << "Failed to commit recomputed ratings:" << transaction.lastError().text();
+        transaction.exec("ROLLBACK");
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::replayRatings() {
+    // Streamed in id order, which is the order the games were saved in and needs no sort; only the ratings,
+    // one per player, are held in memory
+    QHash<QString, PlayerRating> ratings;
+    QSqlQuery games(db);
+    games.setForwardOnly(true);
+    bool ok = games.exec("SELECT player1, player2, outcome, ai_difficulty FROM game_history ORDER BY id");
+    while (ok && games.next()) {
+        const QString player2 = ratedPlayer(games.value(1).toString(), games.value(3).toString());
+        PlayerRating first = ratings.value(games.value(0).toString());
+        PlayerRating second = ratings.value(player2);
+        first.player = games.value(0).toString();
+        second.player = player2;
+        if (rate(first, second, static_cast<GameOutcome>(games.value(2).toInt()))) {
+            ratings.insert(first.player, first);
+            ratings.insert(second.player, second);
+        }
+    }
+    if (!ok) {
+        qDebug() << "Failed to replay game history:" << games.lastError().text();
+    }
+    games.finish();
+
+    QSqlQuery write(db);
+    ok = ok && write.exec("DELETE FROM ratings");
+    write.prepare("INSERT INTO ratings (player, rating, games) VALUES (:player, :rating, :games)");
+    for (auto it = ratings.constBegin(); ok && it != ratings.constEnd(); ++it) {
+        write.bindValue(":player", it.value().player);
+        write.bindValue(":rating", it.value().rating);
+        write.bindValue(":games", it.value().games);
+        ok = write.exec();
+    }
+    if (!ok) {
+        qDebug() << "Failed to recompute ratings:" << write.lastError().text();
+    }
+    return ok;
+}
+
 QVariantMap DatabaseManager::getUserInfo(const QString& username) {
     QVariantMap userInfo;
     if (!db.isOpen()) {
@@ -210,8 +815,7 @@ QVariantMap DatabaseManager::getUserInfo(const QString& username) {
         return userInfo;
     }
 
-    QSqlQuery query(db); // Associate query with the current database connection
-    query.prepare("SELECT firstName, lastName, username FROM users WHERE username = :username");
+    QSqlQuery &query = statement(GetUserInfoStatement);
     query.bindValue(":username", username);
 
     if (query.exec() && query.next()) { // Execute query and check if a user was found
@@ -221,23 +825,51 @@ QVariantMap DatabaseManager::getUserInfo(const QString& username) {
     } else {
         qDebug() << "Failed to get user info:" << query.lastError().text();
     }
+    query.finish(); // Release the statement for the next call
     return userInfo;
 }
 
+UserStats DatabaseManager::getUserStats(const QString& username) {
+    UserStats stats;
+    if (!db.isOpen()) {
+        qDebug() << "Database not open.";
+        return stats;
+    }
+
+    QSqlQuery &query = statement(GetUserStatsStatement);
+    query.bindValue(":username", username);
+
+    if (!query.exec()) {
+        qDebug() << "Failed to get user stats:" << query.lastError().text();
+    } else if (query.next()) { // No row until the user's first game
+        stats.games = query.value("games").toInt();
+        stats.wins = query.value("wins").toInt();
+        stats.losses = query.value("losses").toInt();
+        stats.draws = query.value("draws").toInt();
+    }
+    query.finish();
+    return stats;
+}
+
 QString DatabaseManager::getGameMoves(int gameId) {
+    return movesToText(getGameRecord(gameId));
+}
+
+GameRecord DatabaseManager::getGameRecord(int gameId) {
     if (!db.isOpen()) {
         qDebug() << "Database not open.";
-        return QString();
+        return GameRecord();
     }
 
-    QSqlQuery query(db); // Associate query with the current database connection
-    query.prepare("SELECT moves FROM game_history WHERE id = :gameId");
+    QSqlQuery &query = statement(GetGameMovesStatement);
     query.bindValue(":gameId", gameId);
 
+    GameRecord moves; // Stays empty if not found or failed
     if (query.exec() && query.next()) { // Execute query and check if a record was found
-        return query.value(0).toString(); // Return the 'moves' column value
+        moves = movesFromColumn(query.value(0)); // Decode the 'moves' column value
     } else {
         qDebug() << "Failed to get game moves:" << query.lastError().text();
     }
-    return QString(); // Return empty string if not found or failed
+    query.finish(); // Release the statement for the next call
+    return moves;
 }
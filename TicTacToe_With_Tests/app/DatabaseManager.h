@@ -9,6 +9,55 @@
 #include <QStringList>
 #include <QDebug>
 #include <QVariantMap>
+#include <QByteArray>
+#include <QVector>
+#include <QDateTime>
+#include "EloRating.h"
+#include "GameRecord.h"
+#include <array>
+#include <optional>
+
+// game_history.outcome, seen from player1 (the logged-in user, who plays X)
+enum class GameOutcome {
+    Unknown = 0, // A result text outcomeFromResult() does not know
+    Player1Won = 1,
+    Player2Won = 2,
+    Draw = 3
+};
+
+// One row of user_stats: a user's totals over every stored game, from their own side
+struct UserStats {
+    int games = 0;
+    int wins = 0;
+    int losses = 0;
+    int draws = 0;
+};
+
+// A player's Elo rating (see EloRating.h); each AI difficulty is rated as a player named by aiPlayerName()
+struct PlayerRating {
+    QString player;
+    double rating = EloRating::INITIAL_RATING;
+    int games = 0;          // Rated games: known outcome, two different players
+};
+
+// A finished game waiting to be written to game_history
+struct FinishedGame {
+    QString player1;
+    QString player2;
+    QString result;
+    GameRecord moves;
+    QString aiDifficulty; // Set when player2 is the AI; stored beside it, so the opponent's name stays "AI"
+};
+
+// One line of a user's history list. Leaves out the moves, which only a replay needs (getGameRecord).
+struct GameHistoryEntry {
+    int id = 0;
+    QString player1;
+    QString player2;
+    QString result;
+    QDateTime playedAt;
+    QString timestamp; // playedAt as stored; with id, the position the next page starts after
+};
 
 // REMOVE THIS LINE:
 // class TestDatabaseManager; // Only forward declare classes that are friends *and* defined elsewhere.
@@ -30,17 +79,110 @@ public:
     ~DatabaseManager();
 
     bool initializeDatabase();
-bool registerUser(const QString &username, const QString &password, const QString &email, const QString &firstName, const QString &lastName);
+    bool registerUser(const QString &username, const QString &password, const QString &firstName, const QString &lastName);
+    // Sign-up form variant; the users table has no email column yet, so the address is not stored
+    bool registerUser(const QString &username, const QString &password, const QString &email, const QString &firstName, const QString &lastName);
     bool authenticateUser(const QString &username, const QString &password);
     bool resetUserPassword(const QString &username, const QString &newPassword);
-    bool saveGameHistory(const QString &player1, const QString &player2, const QString &result, const QStringList &moves);
+    bool saveGameHistory(const QString &player1, const QString &player2, const QString &result, const GameRecord &moves);
+    // Older "row:col:X" move list, played on `variant` (the text form has no board size of its own); parsed and
+    // stored in the same binary form. Fails if a move is off that board.
+    bool saveGameHistory(const QString &player1, const QString &player2, const QString &result, const QStringList &moves,
+                         BoardVariant variant = BoardVariant::Classic3x3);
+    // Saves all games in one transaction (one disk sync), with their rating updates; on failure none of them
+    // are saved
+    bool saveGameHistoryBatch(const QVector<FinishedGame> &games);
     QList<QVariantMap> loadGameHistory(const QString &username);
+    // Up to `limit` of the user's games, newest first, starting just after `after` (from the newest game if it
+    // is null). Pages are keyed on (timestamp, id) rather than an OFFSET, so each one costs the same no
+    // matter how deep into the history it is, and games saved or deleted meanwhile do not shift it.
+    QVector<GameHistoryEntry> loadGameHistoryPage(const QString &username, int limit, const GameHistoryEntry *after = nullptr);
+    // SQLite's EXPLAIN QUERY PLAN lines for loadGameHistory's query, to check it uses the player indexes
+    QStringList explainHistoryQuery(const QString &username);
     bool deleteGameHistory(int gameId);
     QVariantMap getUserInfo(const QString& username);
-    QString getGameMoves(int gameId);
+    // Read from user_stats, which triggers on game_history keep up to date, so it costs one lookup however many
+    // games the user has. All zero for a user with no games.
+    UserStats getUserStats(const QString& username);
+
+    // Ratings are updated with each game saved. Deleting a game does not undo its update (Elo depends on the
+    // order of games); recomputeRatings() replays the remaining history from scratch.
+    PlayerRating getRating(const QString& player); // Initial rating for a player with no rated games
+    QVector<PlayerRating> topRatings(int count);   // Highest first, read in order from the ratings index
+    // Replays every game in the order it was saved, holding one rating per player in memory, never the games
+    bool recomputeRatings();
+    // SQLite's EXPLAIN QUERY PLAN lines for topRatings' query
+    QStringList explainLeaderboardQuery(int count);
+    // Name an AI difficulty is rated under, e.g. "AI (hard)". game_history and user_stats keep the opponent as
+    // "AI" whatever the difficulty, as games saved before difficulties were recorded have it.
+    static QString aiPlayerName(const QString& difficulty);
+    GameRecord getGameRecord(int gameId); // Empty record if the game does not exist
+    QString getGameMoves(int gameId);     // Same moves as comma-separated "row:col:X" entries
+    QString databaseFileName() const { return db.databaseName(); }
+    // This thread's pooled connection, for running other SQL against the same database. A manager must only be
+    // used from the thread that created it.
+    QSqlDatabase connection() const { return db; }
+
+    // Stored form of a game's moves: one byte for the board variant, then one byte per move (cell index).
+    // A 3x3 game takes at most 10 bytes, against about 50 for the old "row:col:X,..." text.
+    static QByteArray encodeMoves(const GameRecord &moves);
+    static bool decodeMoves(const QByteArray &bytes, GameRecord &moves);
+    // The old text form, read as moves on `variant`; false if one is off that board
+    static bool parseTextMoves(const QString &text, BoardVariant variant, GameRecord &moves);
+    // Same, for rows stored as text, which carry no board size: taken as the smallest variant that holds every
+    // coordinate. Those rows all predate the larger boards, so in practice this is always 3x3.
+    static bool parseTextMoves(const QString &text, GameRecord &moves);
+    static QString movesToText(const GameRecord &moves);
+    // Outcome of a result text from GameLogic::processGameEnd ("Player X wins!", "AI wins!", ...)
+    static GameOutcome outcomeFromResult(const QString &result);
+
+    // Prepared statement cache: how often a statement had to be prepared, and how often a prepared one was reused
+    quint64 statementPrepareCount() const { return statementPreparations; }
+    quint64 statementCacheHitCount() const { return statementHits; }
 
 private:
+    // Statements prepared once per connection and then only rebound and re-run
+    enum Statement {
+        RegisterUserStatement,
+        AuthenticateUserStatement,
+        ResetPasswordStatement,
+        SaveGameStatement,
+        LoadHistoryStatement,
+        LoadHistoryPageStatement,
+        DeleteGameStatement,
+        GetUserInfoStatement,
+        GetGameMovesStatement,
+        GetUserStatsStatement,
+        GetRatingStatement,
+        SaveRatingStatement,
+        TopRatingsStatement,
+        StatementCount
+    };
+    struct CachedStatement {
+        std::optional<QSqlQuery> query; // Created on first use, bound to db
+        bool prepared = false;
+    };
+
     QSqlDatabase db;
+    std::array<CachedStatement, StatementCount> statements;
+    quint64 statementPreparations = 0;
+    quint64 statementHits = 0;
+
+    QSqlQuery &statement(Statement id); // The prepared statement, preparing it on first use
+    void clearStatements();
+
+    bool migrateTextMoves(); // Rewrites rows saved before moves were stored as BLOBs
+    bool migrateOutcomes();  // Adds and fills the outcome column in databases created before it
+    bool migrateAiDifficulty(); // Adds the ai_difficulty column (NULL for the games already stored)
+    bool createUserStats();  // Creates user_stats and its triggers, counting the games already stored
+    bool createRatings();    // Creates the ratings table, rating the games already stored
+    bool replayRatings();    // recomputeRatings() without the transaction; the caller holds the write lock
+    bool readRating(const QString &player, PlayerRating &rating);
+    bool saveRating(const PlayerRating &rating);
+    bool rateGame(const QString &player1, const QString &player2, GameOutcome outcome); // Part of a save
+    QStringList explain(Statement id, const QVariantMap &bindings);
+    static GameRecord movesFromColumn(const QVariant &value);
+    static QString ratedPlayer(const QString &player2, const QString &aiDifficulty); // Who player2's rating belongs to
 };
 
 #endif // DATABASEMANAGER_H
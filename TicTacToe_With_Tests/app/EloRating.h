@@ -0,0 +1,27 @@
+#ifndef ELORATING_H
+#define ELORATING_H
+
+#include <cmath>
+
+// Elo ratings: after each game both players move towards the result by K times how much it surprised the
+// rating difference. An update only needs the two current ratings, so they can be kept up to date one game at
+// a time, and replaying the games in order from INITIAL_RATING gives back the same numbers.
+namespace EloRating {
+
+constexpr double INITIAL_RATING = 1500.0;
+constexpr double K_FACTOR = 32.0;
+
+// Expected score (1 win, 0.5 draw, 0 loss) of a player rated `rating` against one rated `opponent`
+inline double expectedScore(double rating, double opponent) {
+    return 1.0 / (1.0 + std::pow(10.0, (opponent - rating) / 400.0));
+}
+
+// Applies one game to both ratings; scoreA is player A's score. Zero-sum: A gains what B loses.
+inline void update(double &ratingA, double &ratingB, double scoreA) {
+    const double delta = K_FACTOR * (scoreA - expectedScore(ratingA, ratingB));
+    ratingA += delta;
+    ratingB -= delta;
+}
+}
+
+#endif // ELORATING_H
@@ -0,0 +1,37 @@
+#include "GameCore.h"
+
+GameCore::GameCore(BoardVariant variant)
+    : board(variant), moves(variant) {}
+
+void GameCore::start(BoardVariant variant) {
+    if (variant != board.getVariant()) {
+        board = AnyBoard(variant);
+        moves.reset(variant);
+    }
+    reset();
+}
+
+void GameCore::reset() {
+    board.reset();
+    currentPlayer = Board::PLAYER_X;
+    winner = IN_PROGRESS;
+    moves.clear();
+}
+
+GameCore::MoveResult GameCore::playMove(int row, int col) {
+    if (isOver() || !board.makeMove(row, col, currentPlayer)) {
+        return MoveResult::Invalid;
+    }
+    moves.append(row, col); // The side follows from the move number
+
+    if (board.checkWin() != Board::EMPTY) {
+        winner = currentPlayer; // Only the mover can have just completed a line
+        return MoveResult::Won;
+    }
+    if (board.isFull()) {
+        winner = Board::EMPTY;
+        return MoveResult::Drawn;
+    }
+    currentPlayer = (currentPlayer == Board::PLAYER_X) ? Board::PLAYER_O : Board::PLAYER_X;
+    return MoveResult::Played;
+}
@@ -0,0 +1,44 @@
+#ifndef GAMECORE_H
+#define GAMECORE_H
+
+#include "AnyBoard.h"
+#include "GameRecord.h"
+
+// Game rules without Qt: whose turn it is, win/draw detection and the move list.
+// GameLogic wraps this for the UI; simulations and tests can drive it directly, since a move costs a board
+// update and a win check, with no signals or string building.
+class GameCore {
+public:
+    static constexpr int IN_PROGRESS = -2; // getWinner() while the game is still being played
+
+    enum class MoveResult {
+        Invalid, // Occupied, off the board, or the game is already over; nothing changed
+        Played,  // Accepted; the other player is now to move
+        Won,     // Accepted and the mover completed a line
+        Drawn    // Accepted and filled the board without a line
+    };
+
+    explicit GameCore(BoardVariant variant = BoardVariant::Classic3x3);
+
+    // Clears the board, hands the first move to X and switches board size if needed
+    void start(BoardVariant variant);
+    void reset();
+
+    // Plays (row, col) for the player to move
+    MoveResult playMove(int row, int col);
+
+    int getCurrentPlayer() const { return currentPlayer; }
+    int getWinner() const { return winner; } // PLAYER_X, PLAYER_O, EMPTY for a draw, or IN_PROGRESS
+    bool isOver() const { return winner != IN_PROGRESS; }
+    BoardVariant getVariant() const { return board.getVariant(); }
+    const AnyBoard& getBoard() const { return board; }
+    const GameRecord& getMoves() const { return moves; }
+
+private:
+    AnyBoard board;
+    int currentPlayer = Board::PLAYER_X; // X always starts
+    int winner = IN_PROGRESS;            // Kept up to date by playMove, so reading it never rescans the board
+    GameRecord moves;
+};
+
+#endif // GAMECORE_H
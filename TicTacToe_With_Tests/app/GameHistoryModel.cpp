@@ -0,0 +1,107 @@
+#include "GameHistoryModel.h"
+
+namespace {
+const QString NO_HISTORY_TEXT = "No game history available.";
+}
+
+GameHistoryModel::GameHistoryModel(DatabaseManager *database, QObject *parent, int pageSize)
+    : QAbstractListModel(parent),
+    database(database),
+    pageSize(qMax(1, pageSize))
+{
+}
+
+void GameHistoryModel::setUser(const QString &username)
+{
+    beginResetModel();
+    this->username = username;
+    games.clear();
+    games.squeeze(); // A long history scrolled through earlier should not stay allocated
+    lastLoaded = GameHistoryEntry();
+    exhausted = false;
+    endResetModel();
+}
+
+int GameHistoryModel::gameId(int row) const
+{
+    return (row >= 0 && row < games.size()) ? games[row].id : 0;
+}
+
+void GameHistoryModel::removeGame(int row)
+{
+    if (row < 0 || row >= games.size()) {
+        return;
+    }
+    if (games.size() == 1 && exhausted) {
+        // The last game becomes the placeholder row
+        games.clear();
+        emit dataChanged(index(0), index(0));
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    games.remove(row);
+    endRemoveRows();
+}
+
+int GameHistoryModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return showsPlaceholder() ? 1 : games.size();
+}
+
+QVariant GameHistoryModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+    if (showsPlaceholder()) {
+        return role == Qt::DisplayRole ? QVariant(NO_HISTORY_TEXT) : QVariant();
+    }
+
+    const GameHistoryEntry &game = games[index.row()];
+    switch (role) {
+    case Qt::DisplayRole: {
+        const QString opponent = (game.player1 == username) ? game.player2 : game.player1;
+        return QString("vs %1 | Result: %2 | On: %3")
+            .arg(opponent)
+            .arg(game.result)
+            .arg(game.playedAt.toString("yyyy-MM-dd hh:mm"));
+    }
+    case GameIdRole:
+        return game.id;
+    default:
+        return QVariant();
+    }
+}
+
+bool GameHistoryModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !exhausted && !username.isEmpty();
+}
+
+void GameHistoryModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+    const QVector<GameHistoryEntry> page =
+        database->loadGameHistoryPage(username, pageSize, lastLoaded.id > 0 ? &lastLoaded : nullptr);
+
+    if (page.isEmpty()) {
+        if (games.isEmpty()) {
+            beginInsertRows(QModelIndex(), 0, 0); // The placeholder row
+            exhausted = true;
+            endInsertRows();
+        } else {
+            exhausted = true;
+        }
+        return;
+    }
+    lastLoaded = page.last();
+    beginInsertRows(QModelIndex(), games.size(), games.size() + page.size() - 1);
+    games += page;
+    exhausted = page.size() < pageSize;
+    endInsertRows();
+}
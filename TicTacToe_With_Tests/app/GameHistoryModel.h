@@ -0,0 +1,48 @@
+#ifndef GAMEHISTORYMODEL_H
+#define GAMEHISTORYMODEL_H
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QVector>
+#include "DatabaseManager.h"
+
+// One user's game history for a list view, read from the database a page at a time as the view scrolls
+// (canFetchMore/fetchMore). Opening the history loads only the first page, however many games the user has.
+// When the user has no games it shows a single "No game history available." row with no game id.
+class GameHistoryModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DEFAULT_PAGE_SIZE = 50;
+    enum Roles {
+        GameIdRole = Qt::UserRole // int; invalid for the placeholder row
+    };
+
+    explicit GameHistoryModel(DatabaseManager *database, QObject *parent = nullptr, int pageSize = DEFAULT_PAGE_SIZE);
+
+    // Starts over with username's history; nothing is read until the view asks for it
+    void setUser(const QString &username);
+    QString user() const { return username; }
+
+    int gameId(int row) const; // 0 for the placeholder row or a row out of range
+    // Drops a game deleted from the database, without reloading the pages already shown
+    void removeGame(int row);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+private:
+    bool showsPlaceholder() const { return games.isEmpty() && exhausted; }
+
+    DatabaseManager *database;
+    const int pageSize;
+    QString username;
+    QVector<GameHistoryEntry> games; // Loaded so far, newest first
+    GameHistoryEntry lastLoaded;     // Where the next page starts (id 0 before the first); kept when that game is removed
+    bool exhausted = false;          // The last page came back short
+};
+
+#endif // GAMEHISTORYMODEL_H
@@ -0,0 +1,139 @@
+#include "GameHistoryWriter.h"
+#include <QMutexLocker>
+#include <QThread>
+
+GameHistoryWriter::GameHistoryWriter(const QString &databaseFile, QObject *parent, int capacity)
+    : QObject(parent),
+    databaseFile(databaseFile),
+    capacity(qMax(1, capacity))
+{
+    pending.reserve(this->capacity);
+    writerThread.setMaxThreadCount(1);
+    writerThread.start([this]() { run(); });
+}
+
+GameHistoryWriter::~GameHistoryWriter()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        hasWork.wakeOne();
+    }
+    writerThread.waitForDone(); // run() drains the queue before it returns
+}
+
+void GameHistoryWriter::enqueue(const FinishedGame &game)
+{
+    QMutexLocker locker(&mutex);
+    while (pending.size() >= capacity) {
+        spaceAvailable.wait(&mutex);
+    }
+    pending.append(game);
+    ++queuedGames;
+    hasWork.wakeOne();
+}
+
+bool GameHistoryWriter::tryEnqueue(const FinishedGame &game)
+{
+    QMutexLocker locker(&mutex);
+    if (pending.size() >= capacity) {
+        return false;
+    }
+    pending.append(game);
+    ++queuedGames;
+    hasWork.wakeOne();
+    return true;
+}
+
+void GameHistoryWriter::flush()
+{
+    QMutexLocker locker(&mutex);
+    const quint64 target = queuedGames;
+    while (finishedGames < target) {
+        progress.wait(&mutex);
+    }
+}
+
+quint64 GameHistoryWriter::savedGameCount() const
+{
+    QMutexLocker locker(&mutex);
+    return savedGames;
+}
+
+quint64 GameHistoryWriter::failedGameCount() const
+{
+    QMutexLocker locker(&mutex);
+    return failedGames;
+}
+
+quint64 GameHistoryWriter::committedBatchCount() const
+{
+    QMutexLocker locker(&mutex);
+    return committedBatches;
+}
+
+void GameHistoryWriter::run()
+{
+    // Created on this thread, so it gets a connection of its own from the pool
+    DatabaseManager database(nullptr, databaseFile);
+    QVector<FinishedGame> batch;
+    batch.reserve(capacity);
+    for (;;) {
+        {
+            QMutexLocker locker(&mutex);
+            while (pending.isEmpty() && !stopping) {
+                hasWork.wait(&mutex);
+            }
+            if (pending.isEmpty()) {
+                return; // Stopping, and nothing left to write
+            }
+            batch.swap(pending); // Take the whole queue; producers refill the (empty) other buffer
+            spaceAvailable.wakeAll();
+        }
+
+        bool committedAsBatch = false;
+        const int saved = save(database, batch, committedAsBatch);
+        const int failed = batch.size() - saved;
+        if (saved > 0) {
+            emit gamesSaved(saved);
+        }
+        if (failed > 0) {
+            emit gamesFailed(failed);
+        }
+
+        QMutexLocker locker(&mutex);
+        savedGames += saved;
+        failedGames += failed;
+        committedBatches += committedAsBatch ? 1 : saved;
+        finishedGames += batch.size();
+        progress.wakeAll();
+        locker.unlock();
+        batch.clear();
+    }
+}
+
+int GameHistoryWriter::save(DatabaseManager &database, const QVector<FinishedGame> &batch, bool &committedAsBatch)
+{
+    // A failure is usually the database being busy for longer than the connection's timeout, so wait and retry
+    for (int attempt = 0; attempt < SAVE_ATTEMPTS; ++attempt) {
+        if (attempt > 0) {
+            QThread::msleep(RETRY_BACKOFF_MS << (attempt - 1));
+        }
+        if (database.saveGameHistoryBatch(batch)) {
+            committedAsBatch = true;
+            return batch.size();
+        }
+    }
+    if (batch.size() == 1) {
+        return 0;
+    }
+
+    // Still failing: a game the database rejects fails only itself, the others are kept
+    int saved = 0;
+    for (const FinishedGame &game : batch) {
+        if (database.saveGameHistoryBatch({game})) {
+            ++saved;
+        }
+    }
+    return saved;
+}
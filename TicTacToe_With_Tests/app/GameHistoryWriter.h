@@ -0,0 +1,71 @@
+#ifndef GAMEHISTORYWRITER_H
+#define GAMEHISTORYWRITER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
+#include "DatabaseManager.h"
+
+// Write-behind stage for game_history: finished games are queued and a background thread stores them, so
+// the caller never waits on the disk. Whatever has piled up while the previous batch was being written goes
+// into the next one, in a single transaction, so a burst of games costs one disk sync instead of one each.
+// The queue is bounded: enqueue() blocks while it is full, which slows producers down to the disk's pace.
+// A batch the database rejects is retried a few times with a growing pause, then saved game by game so one bad
+// game cannot take the rest of the batch with it; whatever still fails is reported through gamesFailed().
+class GameHistoryWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DEFAULT_CAPACITY = 1024;
+
+    // The writer opens databaseFile from its own thread, so it never shares the caller's connection
+    explicit GameHistoryWriter(const QString &databaseFile, QObject *parent = nullptr, int capacity = DEFAULT_CAPACITY);
+    ~GameHistoryWriter(); // Writes everything still queued before returning
+
+    void enqueue(const FinishedGame &game);    // Waits while the queue is full
+    bool tryEnqueue(const FinishedGame &game); // False instead of waiting when the queue is full
+
+    // Returns once every game queued before the call has been written (or has failed to be). Blocks for as
+    // long as the disk takes, so the GUI refreshes on gamesSaved() instead.
+    void flush();
+
+    quint64 savedGameCount() const;
+    quint64 failedGameCount() const;  // Games the database rejected even when saved on their own
+    quint64 committedBatchCount() const;
+
+signals:
+    // Emitted from the writer thread once a batch is done, before flush() returns for it
+    void gamesSaved(int count);
+    void gamesFailed(int count);
+
+private:
+    static constexpr int SAVE_ATTEMPTS = 3;      // Per batch, before falling back to one game at a time
+    static constexpr int RETRY_BACKOFF_MS = 50;  // Pause after the first failed attempt; doubles after each
+
+    void run(); // Writer thread: drains the queue until the writer is destroyed
+    // Writes one batch, retrying and then splitting it as above; returns how many games were saved
+    int save(DatabaseManager &database, const QVector<FinishedGame> &batch, bool &committedAsBatch);
+
+    const QString databaseFile;
+    const int capacity;
+
+    mutable QMutex mutex;
+    QWaitCondition hasWork;        // Games queued, or stopping
+    QWaitCondition spaceAvailable; // The writer took the queue
+    QWaitCondition progress;       // A batch finished
+    QVector<FinishedGame> pending;
+    bool stopping = false;
+    quint64 queuedGames = 0;   // Ever queued
+    quint64 finishedGames = 0; // Ever written or failed; flush() waits for this to catch up
+    quint64 savedGames = 0;
+    quint64 failedGames = 0;
+    quint64 committedBatches = 0;
+
+    QThreadPool writerThread; // Single thread running run()
+};
+
+#endif // GAMEHISTORYWRITER_H
@@ -0,0 +1,91 @@
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "AnyBoard.h"
+
+// One move of a game, in the order it was played
+struct MoveRecord {
+    std::int16_t row;
+    std::int16_t col;
+    std::int8_t player; // Board::PLAYER_X or Board::PLAYER_O
+};
+
+// The moves of one game, one byte each: the cell index (row * size + col). The side is not stored, since X
+// always opens and the players alternate. Fixed capacity and trivially copyable, so recording a move never
+// allocates and a finished game can be copied or queued as plain bytes.
+class GameRecord {
+public:
+    static constexpr int MAX_MOVES = 15 * 15; // Largest board (Gomoku15x15); every cell index fits in a byte
+
+    explicit GameRecord(BoardVariant variant = BoardVariant::Classic3x3)
+        : variant(variant), boardSize(static_cast<std::uint8_t>(sizeOf(variant))) {}
+
+    // Empties the record and switches it to `variant`
+    void reset(BoardVariant newVariant) {
+        variant = newVariant;
+        boardSize = static_cast<std::uint8_t>(sizeOf(newVariant));
+        length = 0;
+    }
+    void clear() { length = 0; }
+
+    // Appends (row, col) for the next player; the caller has already checked the move is legal
+    void append(int row, int col) { cells[length++] = static_cast<std::uint8_t>(row * boardSize + col); }
+
+    // Appends a raw cell index; false if it is off the board or the record is full
+    bool appendCell(int cell) {
+        if (cell < 0 || cell >= boardSize * boardSize || length >= MAX_MOVES) {
+            return false;
+        }
+        cells[length++] = static_cast<std::uint8_t>(cell);
+        return true;
+    }
+
+    BoardVariant getVariant() const { return variant; }
+    int getBoardSize() const { return boardSize; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    int cell(std::size_t index) const { return cells[index]; }
+    MoveRecord operator[](std::size_t index) const {
+        return {static_cast<std::int16_t>(cells[index] / boardSize), static_cast<std::int16_t>(cells[index] % boardSize),
+                static_cast<std::int8_t>(index % 2 == 0 ? Board::PLAYER_X : Board::PLAYER_O)};
+    }
+    const std::uint8_t* data() const { return cells.data(); } // size() cell indices
+
+    bool operator==(const GameRecord& other) const {
+        if (variant != other.variant || length != other.length) {
+            return false;
+        }
+        for (std::size_t i = 0; i < length; ++i) {
+            if (cells[i] != other.cells[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool operator!=(const GameRecord& other) const { return !(*this == other); }
+
+    static int sizeOf(BoardVariant variant) {
+        switch (variant) {
+        case BoardVariant::Grid4x4: return 4;
+        case BoardVariant::Grid5x5: return 5;
+        case BoardVariant::Gomoku15x15: return 15;
+        case BoardVariant::Classic3x3: break;
+        }
+        return 3;
+    }
+
+private:
+    BoardVariant variant;
+    std::uint8_t boardSize;
+    std::uint8_t length = 0;
+    std::array<std::uint8_t, MAX_MOVES> cells{};
+};
+
+static_assert(std::is_trivially_copyable<GameRecord>::value, "GameRecord is copied and queued as plain bytes");
+
+#endif // GAMERECORD_H
@@ -0,0 +1,158 @@
+#ifndef GRIDBOARD_H
+#define GRIDBOARD_H
+
+#include <array>
+#include <cstdint>
+#include "board.h"
+
+namespace GridBoardDetail {
+// splitmix64 sequence, used to fill each variant's Zobrist table at compile time
+template <int Count>
+constexpr std::array<Board::Hash, Count> makeZobristTable(std::uint64_t seed) {
+    std::array<Board::Hash, Count> table{};
+    std::uint64_t state = 0x4772696442647ULL + seed;
+    for (auto& key : table) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        key = z ^ (z >> 31);
+    }
+    return table;
+}
+}
+
+// N x N board where K marks in a row win (4x4/4, 5x5/4, 15x15/5, ...).
+// Cells are stored as bitboards like Board, and wins are detected incrementally:
+// makeMove only walks the 4 lines through the new mark, so a win check costs O(K) instead of O(N^2).
+template <int N, int K>
+class GridBoard {
+    static_assert(N >= 3 && N <= 15, "GridBoard supports 3x3 up to 15x15");
+    static_assert(K >= 3 && K <= N, "The winning run must fit on the board");
+
+public:
+    static constexpr int SIZE = N;
+    static constexpr int WIN_LENGTH = K;
+    static constexpr int CELL_COUNT = N * N;
+    static constexpr int WORD_COUNT = (CELL_COUNT + 63) / 64;
+
+    using Hash = Board::Hash;
+    using Bits = std::array<std::uint64_t, WORD_COUNT>;
+
+    GridBoard() { reset(); }
+
+    void reset() {
+        xBits.fill(0);
+        oBits.fill(0);
+        moveCount = 0;
+        winner = Board::EMPTY;
+        winningCell = -1;
+        hash = 0;
+    }
+
+    bool makeMove(int row, int col, int player) {
+        // Check for valid move: within bounds and cell is empty
+        if (row < 0 || row >= N || col < 0 || col >= N) {
+            return false;
+        }
+        const int cell = row * N + col;
+        if (testBit(xBits, cell) || testBit(oBits, cell)) {
+            return false;
+        }
+        if (player == Board::PLAYER_X) {
+            setBit(xBits, cell);
+        } else if (player == Board::PLAYER_O) {
+            setBit(oBits, cell);
+        } else {
+            return false;
+        }
+        ++moveCount;
+        hash ^= zobristKey(player, cell);
+
+        // Only lines through the new mark can have been completed by it
+        if (winner == Board::EMPTY && completesLine(row, col, player)) {
+            winner = player;
+            winningCell = cell;
+        }
+        return true;
+    }
+
+    void undoMove(int row, int col) {
+        if (row < 0 || row >= N || col < 0 || col >= N) {
+            return;
+        }
+        const int cell = row * N + col;
+        if (testBit(xBits, cell)) {
+            clearBit(xBits, cell);
+            hash ^= zobristKey(Board::PLAYER_X, cell);
+        } else if (testBit(oBits, cell)) {
+            clearBit(oBits, cell);
+            hash ^= zobristKey(Board::PLAYER_O, cell);
+        } else {
+            return; // Nothing to undo
+        }
+        --moveCount;
+        if (cell == winningCell) {
+            winner = Board::EMPTY;
+            winningCell = -1;
+        }
+    }
+
+    int getCell(int row, int col) const {
+        if (row < 0 || row >= N || col < 0 || col >= N) {
+            return Board::EMPTY; // Out-of-bounds access
+        }
+        const int cell = row * N + col;
+        if (testBit(xBits, cell)) return Board::PLAYER_X;
+        if (testBit(oBits, cell)) return Board::PLAYER_O;
+        return Board::EMPTY;
+    }
+
+    bool isFull() const { return moveCount == CELL_COUNT; }
+    int checkWin() const { return winner; } // Maintained by makeMove/undoMove, so this is O(1)
+    int getMoveCount() const { return moveCount; }
+    Hash getHash() const { return hash; }
+    const Bits& getPlayerBits(int player) const { return player == Board::PLAYER_X ? xBits : oBits; }
+
+    static Hash zobristKey(int player, int cell) {
+        return ZOBRIST_TABLE[(player == Board::PLAYER_X ? 0 : CELL_COUNT) + cell];
+    }
+
+private:
+    static bool testBit(const Bits& bits, int cell) { return (bits[cell >> 6] >> (cell & 63)) & 1u; }
+    static void setBit(Bits& bits, int cell) { bits[cell >> 6] |= std::uint64_t(1) << (cell & 63); }
+    static void clearBit(Bits& bits, int cell) { bits[cell >> 6] &= ~(std::uint64_t(1) << (cell & 63)); }
+
+    // Counts the player's marks through (row, col) along each of the 4 directions, stopping at K
+    bool completesLine(int row, int col, int player) const {
+        const Bits& own = getPlayerBits(player);
+        static constexpr int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (const auto& direction : DIRECTIONS) {
+            int run = 1;
+            for (int sign = -1; sign <= 1; sign += 2) {
+                int r = row + sign * direction[0];
+                int c = col + sign * direction[1];
+                while (run < K && r >= 0 && r < N && c >= 0 && c < N && testBit(own, r * N + c)) {
+                    ++run;
+                    r += sign * direction[0];
+                    c += sign * direction[1];
+                }
+            }
+            if (run >= K) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static constexpr std::array<Hash, 2 * CELL_COUNT> ZOBRIST_TABLE =
+        GridBoardDetail::makeZobristTable<2 * CELL_COUNT>(std::uint64_t(N) * 131 + K); // Fixed seed per variant
+
+    Bits xBits;      // Cells taken by PLAYER_X
+    Bits oBits;      // Cells taken by PLAYER_O
+    int moveCount;
+    int winner;      // Board::EMPTY until a move completes K in a row
+    int winningCell; // Cell of the move that produced the winner, so undoMove can clear it
+    Hash hash;
+};
+
+#endif // GRIDBOARD_H
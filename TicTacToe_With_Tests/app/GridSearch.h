@@ -0,0 +1,412 @@
+#ifndef GRIDSEARCH_H
+#define GRIDSEARCH_H
+
+#include <QPoint>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "board.h"
+#include "ConcurrentTranspositionTable.h"
+#include "SearchControl.h"
+#include "SearchStats.h"
+
+// Iteratively deepened negamax with alpha-beta for any board type exposing the GridBoard interface
+// (SIZE, WIN_LENGTH, CELL_COUNT, makeMove/undoMove/getCell/checkWin/isFull).
+// Used for boards too large to search to the end; leaves are scored by counting open K-windows.
+template <typename BoardType>
+class GridSearch {
+public:
+    static constexpr int N = BoardType::SIZE;
+    static constexpr int K = BoardType::WIN_LENGTH;
+    static constexpr int WIN_SCORE = 1000000; // Reduced by ply so faster wins score higher
+
+    explicit GridSearch(const SearchControl& control = SearchControl()) : control(control) {}
+
+    // Optional table shared between iterations, moves and helper threads; not owned
+    void setTranspositionTable(ConcurrentTranspositionTable* table) { transpositionTable = table; }
+
+    // Lets root moves be searched on helperCount extra threads from pool (which should be reserved
+    // for this search). With 0 helpers the search stays on the calling thread and is deterministic.
+    void setParallelism(QThreadPool* pool, int helperCount) {
+        helperPool = pool;
+        helpers = pool ? std::max(0, helperCount) : 0;
+    }
+
+    // Iterative deepening: searches 1, 2, 3... plies until the control's depth, node or time budget runs out,
+    // and returns the best move of the deepest iteration that finished. Each iteration tries the previous
+    // iteration's best move first, so the alpha-beta window is tight from the start.
+    QPoint findBestMove(const BoardType& currentBoard, int player) {
+        BoardType board = currentBoard; // Searched in place with make/unmake
+        nodesVisited = 0;
+        completedDepth = 0;
+        stats = SearchStats();
+        control.start();
+
+        Moves moves;
+        const int moveCount = collectCandidates(board, moves);
+        if (moveCount == 0) {
+            return QPoint(-1, -1);
+        }
+        int bestCell = moves[0];
+        const int emptyCells = BoardType::CELL_COUNT - countMarks(board);
+        const int maxDepth = control.limits().maxDepth > 0 ? std::min(control.limits().maxDepth, emptyCells)
+                                                           : emptyCells;
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            // Previous best first; the others keep their order
+            const auto previousBest = std::find(moves.begin(), moves.begin() + moveCount, bestCell);
+            std::rotate(moves.begin(), previousBest, previousBest + 1);
+
+            const RootResult result = searchRoot(board, player, moves, moveCount, depth);
+            if (control.stopped()) {
+                break; // Unfinished iteration: keep the previous answer
+            }
+            bestCell = result.cell;
+            completedDepth = depth;
+            if (result.value >= WIN_SCORE - depth || result.value <= -(WIN_SCORE - depth)) {
+                break; // Forced win or loss within the horizon; deeper iterations cannot change it
+            }
+        }
+        return QPoint(bestCell / N, bestCell % N);
+    }
+
+    // Up to maxCount candidate moves for player, best first by a one-ply look: wins, then the static evaluation
+    int rankMoves(const BoardType& currentBoard, int player, int* cells, int maxCount) const {
+        BoardType board = currentBoard;
+        Moves moves;
+        const int moveCount = collectCandidates(board, moves);
+        std::array<std::pair<int, int>, BoardType::CELL_COUNT> scored; // (value, cell)
+        for (int k = 0; k < moveCount; ++k) {
+            const int cell = moves[k];
+            board.makeMove(cell / N, cell % N, player);
+            const int value = board.checkWin() == player ? WIN_SCORE : -evaluate(board, -player);
+            board.undoMove(cell / N, cell % N);
+            scored[k] = {value, cell};
+        }
+        std::stable_sort(scored.begin(), scored.begin() + moveCount,
+                         [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; });
+        const int count = std::min(maxCount, moveCount);
+        for (int k = 0; k < count; ++k) {
+            cells[k] = scored[k].second;
+        }
+        return count;
+    }
+
+    // Win if possible, otherwise block the opponent's immediate win, otherwise play randomly. Each move tried
+    // counts as a node, so lastSearchNodeCount() and lastSearchStats() describe this search too.
+    QPoint findMediumMove(const BoardType& currentBoard, int player, QRandomGenerator& random) {
+        BoardType board = currentBoard;
+        nodesVisited = 0;
+        completedDepth = 1;
+        stats = SearchStats();
+        for (int side : {player, -player}) {
+            for (int cell = 0; cell < BoardType::CELL_COUNT; ++cell) {
+                if (board.makeMove(cell / N, cell % N, side)) {
+                    ++nodesVisited;
+                    const bool wins = board.checkWin() == side;
+                    board.undoMove(cell / N, cell % N);
+                    if (wins) {
+                        return QPoint(cell / N, cell % N);
+                    }
+                }
+            }
+        }
+        return findRandomMove(board, random);
+    }
+
+    static QPoint findRandomMove(const BoardType& board, QRandomGenerator& random) {
+        Moves moves;
+        int moveCount = 0;
+        for (int cell = 0; cell < BoardType::CELL_COUNT; ++cell) {
+            if (board.getCell(cell / N, cell % N) == Board::EMPTY) {
+                moves[moveCount++] = cell;
+            }
+        }
+        if (moveCount == 0) {
+            return QPoint(-1, -1);
+        }
+        const int cell = moves[random.bounded(moveCount)];
+        return QPoint(cell / N, cell % N);
+    }
+
+    quint64 lastSearchNodeCount() const { return nodesVisited; }
+    int lastCompletedDepth() const { return completedDepth; }
+    SearchStats lastSearchStats() const {
+        SearchStats result = stats;
+        result.nodes = nodesVisited;
+        result.completedDepth = completedDepth;
+        return result;
+    }
+
+private:
+    using Moves = std::array<int, BoardType::CELL_COUNT>;
+
+    static constexpr int MAX_PLY = BoardType::CELL_COUNT + 1;
+    static constexpr Board::Hash SIDE_TO_MOVE_KEY = 0x5D1E7C3B9A4F2816ULL; // XORed in when O is to move
+
+    struct RootResult {
+        int cell = -1;
+        int value = -WIN_SCORE - 1;
+        int index = 0; // Position in the move list; the earlier move wins a tie
+    };
+
+    int searchRootMove(BoardType& board, int player, int cell, int depth, int alpha) {
+        board.makeMove(cell / N, cell % N, player);
+        const int value = -negamax(board, -player, depth - 1, 1, -(WIN_SCORE + 1), -alpha);
+        board.undoMove(cell / N, cell % N);
+        return value;
+    }
+
+    // One iteration at the root. The first move (the previous best) is always searched alone to get
+    // a good alpha (Young Brothers Wait); the rest are handed out one at a time to whichever thread
+    // is free, all of them raising a shared alpha as they improve on it. A move listed before the best so
+    // far is searched one point below alpha, so a tie comes back exact and goes to the earlier move, as in
+    // the sequential loop, whatever order the threads finish in.
+    RootResult searchRoot(BoardType& board, int player, const Moves& moves, int moveCount, int depth) {
+        RootResult best;
+        best.cell = moves[0];
+        best.value = searchRootMove(board, player, moves[0], depth, -WIN_SCORE - 1);
+        if (control.stopped()) {
+            return best;
+        }
+
+        if (helpers == 0 || moveCount <= 2) {
+            for (int k = 1; k < moveCount && !control.checkNow(); ++k) {
+                const int value = searchRootMove(board, player, moves[k], depth, best.value);
+                if (control.stopped()) {
+                    break;
+                }
+                if (value > best.value) {
+                    best = {moves[k], value, k};
+                }
+            }
+            return best;
+        }
+
+        std::atomic<int> nextMove{1};
+        std::atomic<bool> aborted{false};
+        std::mutex resultMutex;
+        auto work = [&](GridSearch& searcher) {
+            BoardType local = board;
+            for (int k = nextMove.fetch_add(1); k < moveCount; k = nextMove.fetch_add(1)) {
+                if (aborted.load(std::memory_order_relaxed) || searcher.control.checkNow()) {
+                    aborted.store(true);
+                    return;
+                }
+                int alpha;
+                {
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    alpha = k < best.index ? best.value - 1 : best.value;
+                }
+                const int value = searcher.searchRootMove(local, player, moves[k], depth, alpha);
+                if (searcher.control.stopped()) {
+                    aborted.store(true);
+                    return;
+                }
+                if (value <= alpha) {
+                    continue; // Only an upper bound, and no better than a move already found
+                }
+                std::lock_guard<std::mutex> lock(resultMutex);
+                if (value > best.value || (value == best.value && k < best.index)) {
+                    best = {moves[k], value, k};
+                }
+            }
+        };
+
+        // Helpers share the clock and the cancellation flag, but count their own nodes
+        const int helperCount = std::min(helpers, moveCount - 2);
+        std::vector<GridSearch> helperSearches(helperCount, *this);
+        for (GridSearch& helper : helperSearches) {
+            helper.nodesVisited = 0;
+            helper.stats = SearchStats();
+            helper.helpers = 0;
+            helperPool->start([&work, &helper]() { work(helper); });
+        }
+        work(*this);
+        helperPool->waitForDone();
+
+        for (const GridSearch& helper : helperSearches) {
+            nodesVisited += helper.nodesVisited;
+            stats += helper.stats;
+        }
+        if (aborted.load()) {
+            control.requestStop();
+        }
+        return best;
+    }
+
+    // Mate scores depend on the distance from the root, so the table stores them relative to the node
+    static int toTableScore(int score, int ply) {
+        if (score > WIN_SCORE - MAX_PLY) return score + ply;
+        if (score < -(WIN_SCORE - MAX_PLY)) return score - ply;
+        return score;
+    }
+
+    static int fromTableScore(int score, int ply) {
+        if (score > WIN_SCORE - MAX_PLY) return score - ply;
+        if (score < -(WIN_SCORE - MAX_PLY)) return score + ply;
+        return score;
+    }
+
+    int negamax(BoardType& board, int player, int depth, int ply, int alpha, int beta) {
+        ++nodesVisited;
+        if (control.shouldStop(nodesVisited)) {
+            return 0; // Out of budget or cancelled; the caller discards this iteration
+        }
+        SEARCH_STAT(stats.recordNode(ply));
+        if (board.checkWin() != Board::EMPTY) {
+            SEARCH_STAT(++stats.leafEvaluations);
+            return -(WIN_SCORE - ply); // The previous move won, so the side to move has lost
+        }
+        if (board.isFull()) {
+            SEARCH_STAT(++stats.leafEvaluations);
+            return 0;
+        }
+        if (depth <= 0) {
+            SEARCH_STAT(++stats.leafEvaluations);
+            return evaluate(board, player);
+        }
+
+        const Board::Hash key = board.getHash() ^ (player == Board::PLAYER_O ? SIDE_TO_MOVE_KEY : 0);
+        const int alphaOrig = alpha;
+        int cachedMove = -1;
+        ConcurrentTranspositionTable::Entry entry;
+        SEARCH_STAT(stats.tableProbes += transpositionTable != nullptr);
+        if (transpositionTable && transpositionTable->probe(key, entry)) {
+            SEARCH_STAT(++stats.tableHits);
+            cachedMove = entry.bestMove;
+            if (entry.depth >= depth) {
+                const int score = fromTableScore(entry.score, ply);
+                if (entry.bound == TranspositionTable::EXACT) return score;
+                if (entry.bound == TranspositionTable::LOWER_BOUND) alpha = std::max(alpha, score);
+                if (entry.bound == TranspositionTable::UPPER_BOUND) beta = std::min(beta, score);
+                if (alpha >= beta) return score;
+            }
+        }
+
+        Moves moves;
+        const int moveCount = collectCandidates(board, moves);
+        if (cachedMove >= 0) {
+            // Cached best move first; the others keep their order
+            const auto cached = std::find(moves.begin(), moves.begin() + moveCount, cachedMove);
+            if (cached != moves.begin() + moveCount) {
+                std::rotate(moves.begin(), cached, cached + 1);
+            }
+        }
+        int best = -WIN_SCORE - 1;
+        int bestMove = -1;
+        for (int k = 0; k < moveCount; ++k) {
+            const int cell = moves[k];
+            board.makeMove(cell / N, cell % N, player);
+            const int value = -negamax(board, -player, depth - 1, ply + 1, -beta, -alpha);
+            board.undoMove(cell / N, cell % N);
+            if (value > best) {
+                best = value;
+                bestMove = cell;
+            }
+            alpha = std::max(alpha, best);
+            if (alpha >= beta) {
+                SEARCH_STAT(stats.recordCutoff(ply));
+                break;
+            }
+        }
+
+        if (transpositionTable && !control.stopped()) {
+            TranspositionTable::Bound bound = TranspositionTable::EXACT;
+            if (best <= alphaOrig) {
+                bound = TranspositionTable::UPPER_BOUND;
+            } else if (best >= beta) {
+                bound = TranspositionTable::LOWER_BOUND;
+            }
+            transpositionTable->store(key, toTableScore(best, ply), depth, bestMove, bound);
+        }
+        return best;
+    }
+
+    static int countMarks(const BoardType& board) {
+        int marks = 0;
+        for (int cell = 0; cell < BoardType::CELL_COUNT; ++cell) {
+            marks += board.getCell(cell / N, cell % N) != Board::EMPTY;
+        }
+        return marks;
+    }
+
+    // Empty cells next to an existing mark (or the centre on an empty board); on small boards every empty cell
+    int collectCandidates(const BoardType& board, Moves& moves) const {
+        int moveCount = 0;
+        bool anyMark = false;
+        for (int cell = 0; cell < BoardType::CELL_COUNT && !anyMark; ++cell) {
+            anyMark = board.getCell(cell / N, cell % N) != Board::EMPTY;
+        }
+        if (!anyMark) {
+            moves[moveCount++] = (N / 2) * N + N / 2;
+            return moveCount;
+        }
+
+        for (int cell = 0; cell < BoardType::CELL_COUNT; ++cell) {
+            const int row = cell / N;
+            const int col = cell % N;
+            if (board.getCell(row, col) != Board::EMPTY) {
+                continue;
+            }
+            bool nearMark = N <= 5;
+            for (int dr = -1; dr <= 1 && !nearMark; ++dr) {
+                for (int dc = -1; dc <= 1 && !nearMark; ++dc) {
+                    nearMark = board.getCell(row + dr, col + dc) != Board::EMPTY; // getCell is EMPTY off the board
+                }
+            }
+            if (nearMark) {
+                moves[moveCount++] = cell;
+            }
+        }
+        return moveCount;
+    }
+
+    // Sum over every K-long window: windows holding only one side's marks score 10^(marks - 1) for that side
+    int evaluate(const BoardType& board, int player) const {
+        static constexpr int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        int score = 0;
+        for (int row = 0; row < N; ++row) {
+            for (int col = 0; col < N; ++col) {
+                for (const auto& direction : DIRECTIONS) {
+                    const int endRow = row + (K - 1) * direction[0];
+                    const int endCol = col + (K - 1) * direction[1];
+                    if (endRow < 0 || endRow >= N || endCol < 0 || endCol >= N) {
+                        continue;
+                    }
+                    int own = 0;
+                    int other = 0;
+                    for (int step = 0; step < K; ++step) {
+                        const int cell = board.getCell(row + step * direction[0], col + step * direction[1]);
+                        if (cell == player) ++own;
+                        else if (cell != Board::EMPTY) ++other;
+                    }
+                    if (own > 0 && other == 0) score += windowWeight(own);
+                    else if (other > 0 && own == 0) score -= windowWeight(other);
+                }
+            }
+        }
+        return score;
+    }
+
+    static int windowWeight(int marks) {
+        int weight = 1;
+        for (int i = 1; i < marks; ++i) {
+            weight *= 10;
+        }
+        return weight;
+    }
+
+    SearchControl control;
+    ConcurrentTranspositionTable* transpositionTable = nullptr;
+    QThreadPool* helperPool = nullptr;
+    int helpers = 0;
+    quint64 nodesVisited = 0;
+    int completedDepth = 0;
+    SearchStats stats; // Counters other than nodesVisited and completedDepth
+};
+
+#endif // GRIDSEARCH_H
@@ -0,0 +1,320 @@
+#ifndef MCTSENGINE_H
+#define MCTSENGINE_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "board.h"
+#include "SearchControl.h"
+
+// Counters from the last MctsEngine::findBestMove, for tuning strength against CPU time
+struct MctsStats {
+    quint64 iterations = 0;   // Playouts run by the last call
+    quint64 reusedVisits = 0; // Playouts inherited from the previous tree
+    int treeNodes = 0;        // Arena nodes in use after the last call
+};
+
+// Monte Carlo Tree Search (UCT) for any board type exposing the GridBoard interface.
+// Nodes live in a preallocated arena: expanding a node appends all of its children in one block, so the
+// search itself never allocates. The tree is kept between calls, and when the next position is a child or
+// grandchild of the old root (the AI's move and the reply) that subtree is compacted into the other
+// arena and searched further instead of starting over.
+template <typename BoardType>
+class MctsEngine {
+public:
+    static constexpr int N = BoardType::SIZE;
+    static constexpr quint64 DEFAULT_ITERATIONS = 20000; // Used when the limits set neither time nor nodes
+
+    using Stats = MctsStats;
+
+    explicit MctsEngine(quint64 seed = 0x4D435453ULL, int nodeCapacity = 1 << 18)
+        : capacity(nodeCapacity), randomState(seed | 1) {
+        nodes.reserve(capacity);
+        spare.reserve(capacity);
+    }
+
+    // Runs playouts until the control's budget is spent (nodeBudget counts playouts) and
+    // returns the most visited move
+    QPoint findBestMove(const BoardType& board, int player, SearchControl control) {
+        control.start();
+        if (isTerminal(board)) {
+            return QPoint(-1, -1);
+        }
+        reuseOrReset(board, player);
+        lastRunStats = Stats();
+        lastRunStats.reusedVisits = nodes[0].visits;
+
+        const SearchLimits& limits = control.limits();
+        const bool unlimited = limits.timeBudgetMs <= 0 && limits.nodeBudget == 0;
+        while (!control.shouldStop(lastRunStats.iterations) &&
+               !(unlimited && lastRunStats.iterations >= DEFAULT_ITERATIONS)) {
+            runIteration(board, player);
+            ++lastRunStats.iterations;
+        }
+        lastRunStats.treeNodes = static_cast<int>(nodes.size());
+
+        const Node& root = nodes[0];
+        int bestMove = -1;
+        quint32 bestVisits = 0;
+        for (int c = 0; c < root.childCount; ++c) {
+            const Node& child = nodes[root.firstChild + c];
+            if (bestMove < 0 || child.visits > bestVisits) {
+                bestMove = child.move;
+                bestVisits = child.visits;
+            }
+        }
+        if (bestMove < 0) {
+            bestMove = firstEmptyCell(board); // No playout finished (or the game is over)
+        }
+        return bestMove < 0 ? QPoint(-1, -1) : QPoint(bestMove / N, bestMove % N);
+    }
+
+    void clearTree() {
+        nodes.clear();
+    }
+
+    // Starts over as if newly constructed with this seed, keeping the arenas allocated
+    void reseed(quint64 seed) {
+        randomState = seed | 1;
+        nodes.clear();
+    }
+
+    const Stats& lastStats() const { return lastRunStats; }
+
+private:
+    struct Node {
+        float score = 0;        // Sum of playout results for the player who made move (win 1, draw 0.5)
+        quint32 visits = 0;
+        qint32 firstChild = -1; // Children are contiguous in the arena
+        qint16 childCount = 0;
+        qint16 move = -1;       // Cell played to reach this node
+        qint8 player = 0;       // Who played move
+        bool expanded = false;
+    };
+
+    using Cells = std::array<int, BoardType::CELL_COUNT>;
+    static constexpr float EXPLORATION = 1.41421356f; // sqrt(2), the textbook UCT constant
+
+    void runIteration(const BoardType& rootBoard, int rootPlayer) {
+        BoardType board = rootBoard;
+        std::array<int, BoardType::CELL_COUNT + 2> path;
+        int pathLength = 0;
+        int index = 0;
+        int toMove = rootPlayer;
+        path[pathLength++] = index;
+
+        // Selection: follow UCT down to a node that is not expanded yet
+        while (nodes[index].expanded && nodes[index].childCount > 0) {
+            index = selectChild(nodes[index]);
+            board.makeMove(nodes[index].move / N, nodes[index].move % N, toMove);
+            toMove = -toMove;
+            path[pathLength++] = index;
+        }
+
+        // Expansion: add all children at once, then play one of them
+        if (!isTerminal(board) && !nodes[index].expanded && expand(index, board, toMove)) {
+            const Node& parent = nodes[index];
+            index = parent.firstChild + static_cast<int>(nextRandom() % quint64(parent.childCount));
+            board.makeMove(nodes[index].move / N, nodes[index].move % N, toMove);
+            toMove = -toMove;
+            path[pathLength++] = index;
+        }
+
+        // Simulation and backpropagation
+        const int winner = rollout(board, toMove);
+        for (int i = 0; i < pathLength; ++i) {
+            Node& node = nodes[path[i]];
+            ++node.visits;
+            if (winner == Board::EMPTY) {
+                node.score += 0.5f;
+            } else if (winner == node.player) {
+                node.score += 1.0f;
+            }
+        }
+    }
+
+    int selectChild(const Node& parent) const {
+        const float logVisits = std::log(float(parent.visits));
+        int best = parent.firstChild;
+        float bestValue = -1.0f;
+        for (int c = 0; c < parent.childCount; ++c) {
+            const Node& child = nodes[parent.firstChild + c];
+            if (child.visits == 0) {
+                return parent.firstChild + c; // Every child is tried once before UCT applies
+            }
+            const float value = child.score / child.visits +
+                                EXPLORATION * std::sqrt(logVisits / child.visits);
+            if (value > bestValue) {
+                bestValue = value;
+                best = parent.firstChild + c;
+            }
+        }
+        return best;
+    }
+
+    // Appends the node's children to the arena; false if the arena is full (the node stays a leaf)
+    bool expand(int index, const BoardType& board, int toMove) {
+        Cells moves;
+        const int moveCount = collectCandidates(board, moves);
+        if (moveCount == 0 || nodes.size() + moveCount > std::size_t(capacity)) {
+            return false;
+        }
+        const int first = static_cast<int>(nodes.size());
+        for (int k = 0; k < moveCount; ++k) {
+            Node child;
+            child.move = static_cast<qint16>(moves[k]);
+            child.player = static_cast<qint8>(toMove);
+            nodes.push_back(child); // Within the reserved capacity, so this never reallocates
+        }
+        Node& node = nodes[index];
+        node.firstChild = first;
+        node.childCount = static_cast<qint16>(moveCount);
+        node.expanded = true;
+        return true;
+    }
+
+    // Random playout on the bitboard; returns the winner, or Board::EMPTY for a draw
+    int rollout(BoardType& board, int toMove) {
+        if (board.checkWin() != Board::EMPTY) {
+            return board.checkWin();
+        }
+        Cells empty;
+        int emptyCount = 0;
+        for (int cell = 0; cell < BoardType::CELL_COUNT; ++cell) {
+            if (board.getCell(cell / N, cell % N) == Board::EMPTY) {
+                empty[emptyCount++] = cell;
+            }
+        }
+        while (emptyCount > 0) {
+            const int pick = static_cast<int>(nextRandom() % quint64(emptyCount));
+            const int cell = empty[pick];
+            empty[pick] = empty[--emptyCount];
+            board.makeMove(cell / N, cell % N, toMove);
+            if (board.checkWin() != Board::EMPTY) {
+                return toMove;
+            }
+            toMove = -toMove;
+        }
+        return Board::EMPTY;
+    }
+
+    // Keeps the subtree for this position if the old tree reaches it within one or two plies
+    void reuseOrReset(const BoardType& board, int player) {
+        int found = -1;
+        if (!nodes.empty()) {
+            if (rootHash == board.getHash() && rootPlayer == player) {
+                found = 0;
+            }
+            const Node& root = nodes[0];
+            for (int c = 0; c < root.childCount && found < 0; ++c) {
+                const Node& child = nodes[root.firstChild + c];
+                const Board::Hash childHash = rootHash ^ BoardType::zobristKey(child.player, child.move);
+                if (child.player == -player && childHash == board.getHash()) {
+                    found = root.firstChild + c; // One move later, e.g. when the engine plays both sides
+                }
+                for (int g = 0; g < child.childCount && found < 0; ++g) {
+                    const Node& grandchild = nodes[child.firstChild + g];
+                    if (grandchild.player == -player &&
+                        (childHash ^ BoardType::zobristKey(grandchild.player, grandchild.move)) == board.getHash()) {
+                        found = child.firstChild + g;
+                    }
+                }
+            }
+        }
+
+        if (found > 0) {
+            reroot(found);
+        } else if (found < 0) {
+            nodes.clear();
+            Node root;
+            root.player = static_cast<qint8>(-player);
+            nodes.push_back(root);
+        }
+        rootHash = board.getHash();
+        rootPlayer = player;
+    }
+
+    // Copies the subtree under newRoot into the spare arena breadth-first (keeping children contiguous) and swaps
+    void reroot(int newRoot) {
+        spare.clear();
+        spare.push_back(nodes[newRoot]);
+        for (std::size_t i = 0; i < spare.size(); ++i) {
+            if (spare[i].firstChild < 0) {
+                continue;
+            }
+            const int oldFirst = spare[i].firstChild;
+            spare[i].firstChild = static_cast<qint32>(spare.size());
+            for (int c = 0; c < spare[i].childCount; ++c) {
+                spare.push_back(nodes[oldFirst + c]);
+            }
+        }
+        nodes.swap(spare);
+    }
+
+    static bool isTerminal(const BoardType& board) {
+        return board.checkWin() != Board::EMPTY || board.isFull();
+    }
+
+    // Empty cells next to an existing mark (or the centre on an empty board); on small boards every empty cell
+    static int collectCandidates(const BoardType& board, Cells& moves) {
+        int moveCount = 0;
+        bool anyMark = false;
+        for (int cell = 0; cell < BoardType::CELL_COUNT && !anyMark; ++cell) {
+            anyMark = board.getCell(cell / N, cell % N) != Board::EMPTY;
+        }
+        if (!anyMark && N > 5) {
+            moves[moveCount++] = (N / 2) * N + N / 2;
+            return moveCount;
+        }
+        for (int cell = 0; cell < BoardType::CELL_COUNT; ++cell) {
+            const int row = cell / N;
+            const int col = cell % N;
+            if (board.getCell(row, col) != Board::EMPTY) {
+                continue;
+            }
+            bool nearMark = N <= 5;
+            for (int dr = -1; dr <= 1 && !nearMark; ++dr) {
+                for (int dc = -1; dc <= 1 && !nearMark; ++dc) {
+                    nearMark = board.getCell(row + dr, col + dc) != Board::EMPTY; // getCell is EMPTY off the board
+                }
+            }
+            if (nearMark) {
+                moves[moveCount++] = cell;
+            }
+        }
+        return moveCount;
+    }
+
+    static int firstEmptyCell(const BoardType& board) {
+        if (isTerminal(board)) {
+            return -1;
+        }
+        for (int cell = 0; cell < BoardType::CELL_COUNT; ++cell) {
+            if (board.getCell(cell / N, cell % N) == Board::EMPTY) {
+                return cell;
+            }
+        }
+        return -1;
+    }
+
+    // xorshift64*: rollouts draw one number per move, so this needs to be cheap rather than strong
+    quint64 nextRandom() {
+        randomState ^= randomState >> 12;
+        randomState ^= randomState << 25;
+        randomState ^= randomState >> 27;
+        return randomState * 0x2545F4914F6CDD1DULL;
+    }
+
+    int capacity;
+    std::vector<Node> nodes; // Arena; nodes[0] is the root
+    std::vector<Node> spare; // Second arena, the target of reroot
+    Board::Hash rootHash = 0;
+    int rootPlayer = 0;
+    quint64 randomState;
+    Stats lastRunStats;
+};
+
+#endif // MCTSENGINE_H
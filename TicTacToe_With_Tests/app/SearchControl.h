@@ -0,0 +1,92 @@
+#ifndef SEARCHCONTROL_H
+#define SEARCHCONTROL_H
+
+#include <QtGlobal>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+// Per-move budget for the AI. Zero means "no limit" for each field.
+struct SearchLimits {
+    int maxDepth = 0;        // Deepest iteration to run (plies)
+    qint64 timeBudgetMs = 0; // Wall-clock time for one move
+    quint64 nodeBudget = 0;  // Nodes for one move (per thread); deterministic, unlike the time budget
+};
+
+// Tells a running search when to give up early: when its budget is spent, or when the owner
+// bumps its generation counter (a newer request, a reset, or leaving the game).
+class SearchControl
+{
+public:
+    SearchControl() = default;
+    explicit SearchControl(const SearchLimits& limits) : searchLimits(limits) {}
+
+    void setLimits(const SearchLimits& limits) { searchLimits = limits; }
+    const SearchLimits& limits() const { return searchLimits; }
+
+    void setCancellation(const std::atomic<quint64>* generationCounter, quint64 expected) {
+        generation = generationCounter;
+        expectedGeneration = expected;
+    }
+
+    // Starts the clock for a new search. Under a shared deadline it gets its share of the time left.
+    void start() {
+        const auto now = std::chrono::steady_clock::now();
+        stopRequested = false;
+        deadline = now + std::chrono::milliseconds(searchLimits.timeBudgetMs);
+        if (sharingDeadline) {
+            const auto left = std::max(sharedDeadline - now, std::chrono::steady_clock::duration::zero());
+            deadline = std::min(deadline, now + left / sharedSearches);
+        }
+    }
+
+    // Makes the searches started from now until endSharedDeadline() share one time budget, counted from now,
+    // instead of each getting a full one (e.g. the several searches of one ponder pass)
+    void beginSharedDeadline() {
+        sharedDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(searchLimits.timeBudgetMs);
+        sharedSearches = 1;
+        sharingDeadline = true;
+    }
+    // The next search started gets 1/searches of the time left, so the ones after it still get theirs
+    void shareDeadlineAmong(int searches) { sharedSearches = std::max(1, searches); }
+    void endSharedDeadline() { sharingDeadline = false; }
+
+    // Called once per node with the running node count; reads the clock only every 1024 nodes
+    bool shouldStop(quint64 nodes) {
+        if (!stopRequested) {
+            if (searchLimits.nodeBudget > 0 && nodes >= searchLimits.nodeBudget) {
+                stopRequested = true;
+            } else if ((nodes & 1023) == 0) {
+                checkNow();
+            }
+        }
+        return stopRequested;
+    }
+
+    // Checks cancellation and the clock immediately, e.g. between root moves
+    bool checkNow() {
+        if (!stopRequested) {
+            const bool cancelled = generation && generation->load(std::memory_order_relaxed) != expectedGeneration;
+            const bool outOfTime = searchLimits.timeBudgetMs > 0 && std::chrono::steady_clock::now() >= deadline;
+            stopRequested = cancelled || outOfTime;
+        }
+        return stopRequested;
+    }
+
+    bool stopped() const { return stopRequested; }
+
+    // Marks the search as stopped, e.g. when a helper thread ran out of budget
+    void requestStop() { stopRequested = true; }
+
+private:
+    SearchLimits searchLimits;
+    const std::atomic<quint64>* generation = nullptr; // Owned by the caller; null means never cancelled
+    quint64 expectedGeneration = 0;
+    std::chrono::steady_clock::time_point deadline;
+    std::chrono::steady_clock::time_point sharedDeadline;
+    int sharedSearches = 1; // Searches left to share the time until sharedDeadline
+    bool sharingDeadline = false;
+    bool stopRequested = false;
+};
+
+#endif // SEARCHCONTROL_H
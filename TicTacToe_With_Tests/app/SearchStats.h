@@ -0,0 +1,81 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <QMetaType>
+#include <QtGlobal>
+#include <algorithm>
+#include <array>
+#include "board.h"
+
+// The counters below are updated inside the search loops. Build with DEFINES += AI_SEARCH_STATS=0 to compile
+// those updates out; SearchStats then only reports what the search tracks anyway (nodes, depth, time).
+#ifndef AI_SEARCH_STATS
+#define AI_SEARCH_STATS 1
+#endif
+
+#if AI_SEARCH_STATS
+#define SEARCH_STAT(statement) statement
+#else
+#define SEARCH_STAT(statement) static_cast<void>(0)
+#endif
+
+// Work done by one AI search, for tuning and regression tracking
+struct SearchStats {
+    static constexpr int TRACKED_PLIES = 16; // Cutoffs deeper than this are counted in the last slot
+
+    quint64 nodes = 0;           // Positions searched (or MCTS playouts)
+    quint64 leafEvaluations = 0; // Positions scored without looking further: won, full, or at the horizon
+    quint64 cutoffs = 0;         // Alpha-beta cutoffs: nodes that stopped before trying every move
+    std::array<quint64, TRACKED_PLIES> cutoffsByPly{}; // Ply 1 is the root's children
+    quint64 tableProbes = 0;     // Transposition table lookups
+    quint64 tableHits = 0;       // Lookups that found the position
+    int maxPly = 0;              // Deepest ply reached
+    int completedDepth = 0;      // Deepest iterative-deepening iteration that finished
+    qint64 elapsedNanoseconds = 0;
+    bool precomputed = false;    // Answered by the solved table or a pondered result; nothing was searched
+
+    void recordNode(int ply) { maxPly = std::max(maxPly, ply); }
+    void recordCutoff(int ply) {
+        ++cutoffs;
+        ++cutoffsByPly[std::min(ply, TRACKED_PLIES - 1)];
+    }
+
+    // Adds a helper thread's counters to these
+    SearchStats& operator+=(const SearchStats& other) {
+        nodes += other.nodes;
+        leafEvaluations += other.leafEvaluations;
+        cutoffs += other.cutoffs;
+        for (int ply = 0; ply < TRACKED_PLIES; ++ply) {
+            cutoffsByPly[ply] += other.cutoffsByPly[ply];
+        }
+        tableProbes += other.tableProbes;
+        tableHits += other.tableHits;
+        maxPly = std::max(maxPly, other.maxPly);
+        return *this;
+    }
+};
+
+Q_DECLARE_METATYPE(SearchStats)
+
+// Exhaustive count of the game tree below board, player to move, without any pruning (perft). stats.nodes counts
+// every position including the root, stats.leafEvaluations every finished game (or position at maxDepth plies;
+// 0 = play every game out). From the empty 3x3 board: 549,946 positions and 255,168 games.
+template <typename BoardType>
+void perft(BoardType& board, int player, int maxDepth, SearchStats& stats, int ply = 0) {
+    ++stats.nodes;
+    stats.recordNode(ply);
+    if (board.checkWin() != Board::EMPTY || board.isFull() || (maxDepth > 0 && ply >= maxDepth)) {
+        ++stats.leafEvaluations;
+        return;
+    }
+    for (int cell = 0; cell < BoardType::CELL_COUNT; ++cell) {
+        const int row = cell / BoardType::SIZE;
+        const int col = cell % BoardType::SIZE;
+        if (board.makeMove(row, col, player)) {
+            perft(board, -player, maxDepth, stats, ply + 1);
+            board.undoMove(row, col);
+        }
+    }
+}
+
+#endif // SEARCHSTATS_H
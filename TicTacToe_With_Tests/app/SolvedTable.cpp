@@ -0,0 +1,184 @@
+#include "SolvedTable.h"
+#include "WinKernel.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+// Each table byte packs the best cell in the low nibble and the Outcome in bits 4-5
+constexpr std::uint8_t NO_MOVE = 0x0F;
+
+constexpr std::array<int, 9> POWERS_OF_THREE = {{ 1, 3, 9, 27, 81, 243, 729, 2187, 6561 }};
+
+// Memoized negamax over base-3 keys, evaluated entirely by the compiler
+struct TableBuilder {
+    std::array<std::uint8_t, SolvedTable::POSITION_COUNT> table{};
+
+    // Returns the value for the side to move: 1 win, 0 draw, -1 loss
+    constexpr int solve(int key, Board::Mask mover, Board::Mask opponent, int moverDigit) {
+        if (table[key] != 0) {
+            const int outcome = table[key] >> 4;
+            return outcome == SolvedTable::WIN ? 1 : (outcome == SolvedTable::DRAW ? 0 : -1);
+        }
+
+        int best = -2;
+        int bestCell = NO_MOVE;
+        const Board::Mask occupied = mover | opponent;
+        for (int cell = 0; cell < 9; ++cell) { // No cutoff: every reachable position gets an entry
+            const Board::Mask bit = static_cast<Board::Mask>(1u << cell);
+            if (occupied & bit) {
+                continue;
+            }
+            const Board::Mask next = mover | bit;
+            int value = 0;
+            if (Board::hasLine(next)) {
+                value = 1; // This move wins on the spot
+            } else if ((occupied | bit) == Board::FULL_MASK) {
+                value = 0; // Last cell filled without a line
+            } else {
+                value = -solve(key + POWERS_OF_THREE[cell] * moverDigit, opponent, next, 3 - moverDigit);
+            }
+            // Strictly better only, so ties keep the first cell in row-major order (same as minimax)
+            if (value > best) {
+                best = value;
+                bestCell = cell;
+            }
+        }
+
+        const int outcome = best > 0 ? SolvedTable::WIN : (best == 0 ? SolvedTable::DRAW : SolvedTable::LOSS);
+        table[key] = static_cast<std::uint8_t>((outcome << 4) | bestCell);
+        return best;
+    }
+};
+
+constexpr std::array<std::uint8_t, SolvedTable::POSITION_COUNT> buildTable() {
+    TableBuilder builder;
+    builder.solve(0, 0, 0, 1); // X (digit 1) moves first from the empty board
+    return builder.table;
+}
+
+// ~19 KB, one byte per base-3 key; positions that can never occur stay 0 (UNSOLVED)
+constexpr std::array<std::uint8_t, SolvedTable::POSITION_COUNT> SOLVED_TABLE = buildTable();
+
+// Base-3 value of every 9-bit mask with digit 1 per set bit, so a packed position needs two lookups
+constexpr std::array<std::uint16_t, 512> makeTernaryDigits() {
+    std::array<std::uint16_t, 512> digits{};
+    for (int bits = 0; bits < 512; ++bits) {
+        int value = 0;
+        for (int cell = 0; cell < 9; ++cell) {
+            if (bits & (1 << cell)) {
+                value += POWERS_OF_THREE[cell];
+            }
+        }
+        digits[bits] = static_cast<std::uint16_t>(value);
+    }
+    return digits;
+}
+
+constexpr std::array<std::uint8_t, 512> makeCellCounts() {
+    std::array<std::uint8_t, 512> counts{};
+    for (int bits = 0; bits < 512; ++bits) {
+        counts[bits] = static_cast<std::uint8_t>(Board::countCells(static_cast<Board::Mask>(bits)));
+    }
+    return counts;
+}
+
+constexpr std::array<std::uint16_t, 512> TERNARY_DIGITS = makeTernaryDigits();
+constexpr std::array<std::uint8_t, 512> CELL_COUNTS = makeCellCounts();
+
+constexpr std::size_t EVALUATION_BLOCK = 256;
+
+// Positions the table has no entry for: finished games and boards no legal game can reach
+SolvedTable::Evaluation evaluateUnsolved(Board::Mask x, Board::Mask o, std::uint8_t status) {
+    const bool xToMove = CELL_COUNTS[x] <= CELL_COUNTS[o];
+    const bool moverHasLine = status & (xToMove ? WinKernel::X_LINE : WinKernel::O_LINE);
+    const bool previousMoveWon = status & (xToMove ? WinKernel::O_LINE : WinKernel::X_LINE);
+    if (previousMoveWon && !moverHasLine) {
+        return {-1, -1};
+    }
+    return {-1, 0}; // Draw, or a position that cannot occur
+}
+}
+
+namespace SolvedTable {
+
+int positionKey(const Board& board) {
+    const Board::Mask xMask = board.getPlayerMask(Board::PLAYER_X);
+    const Board::Mask oMask = board.getPlayerMask(Board::PLAYER_O);
+    int key = 0;
+    for (int cell = 0; cell < 9; ++cell) {
+        const Board::Mask bit = static_cast<Board::Mask>(1u << cell);
+        if (xMask & bit) {
+            key += POWERS_OF_THREE[cell];
+        } else if (oMask & bit) {
+            key += 2 * POWERS_OF_THREE[cell];
+        }
+    }
+    return key;
+}
+
+int sideToMove(const Board& board) {
+    const int xCount = Board::countCells(board.getPlayerMask(Board::PLAYER_X));
+    const int oCount = Board::countCells(board.getPlayerMask(Board::PLAYER_O));
+    return xCount == oCount ? Board::PLAYER_X : Board::PLAYER_O;
+}
+
+int bestMove(const Board& board, int player) {
+    if (player != sideToMove(board)) {
+        return -1; // The table only covers games where X moved first
+    }
+    const std::uint8_t entry = SOLVED_TABLE[positionKey(board)];
+    const int cell = entry & 0x0F;
+    if ((entry >> 4) == UNSOLVED || cell == NO_MOVE) {
+        return -1;
+    }
+    return cell;
+}
+
+Outcome outcome(const Board& board) {
+    return static_cast<Outcome>(SOLVED_TABLE[positionKey(board)] >> 4);
+}
+
+void evaluate(const Board::PackedPosition* positions, std::size_t count, Evaluation* results) {
+    int keys[EVALUATION_BLOCK];
+    std::uint8_t status[EVALUATION_BLOCK];
+    for (std::size_t start = 0; start < count; start += EVALUATION_BLOCK) {
+        const std::size_t blockSize = std::min(EVALUATION_BLOCK, count - start);
+        const Board::PackedPosition* block = positions + start;
+
+        // Pass 1: base-3 keys with the player who opened as X; -1 for overlapping or impossible mark counts
+        for (std::size_t i = 0; i < blockSize; ++i) {
+            const unsigned x = block[i] & Board::FULL_MASK;
+            const unsigned o = (block[i] >> 9) & Board::FULL_MASK;
+            const int xCount = CELL_COUNTS[x];
+            const int oCount = CELL_COUNTS[o];
+            const bool oOpened = oCount > xCount;
+            const bool valid = (x & o) == 0 && xCount - oCount <= 1 && oCount - xCount <= 1;
+            const int key = oOpened ? TERNARY_DIGITS[o] + 2 * TERNARY_DIGITS[x]
+                                    : TERNARY_DIGITS[x] + 2 * TERNARY_DIGITS[o];
+            keys[i] = valid ? key : -1;
+        }
+
+        // Finished games are not in the table; their status comes from the SIMD win kernel
+        WinKernel::classify(block, blockSize, status);
+
+        // Pass 2: table lookups
+        for (std::size_t i = 0; i < blockSize; ++i) {
+            if (keys[i] < 0) {
+                results[start + i] = {-1, 0};
+                continue;
+            }
+            const std::uint8_t entry = SOLVED_TABLE[keys[i]];
+            const int outcome = entry >> 4;
+            if (outcome == UNSOLVED) {
+                const Board::Mask x = static_cast<Board::Mask>(block[i] & Board::FULL_MASK);
+                const Board::Mask o = static_cast<Board::Mask>((block[i] >> 9) & Board::FULL_MASK);
+                results[start + i] = evaluateUnsolved(x, o, status[i]);
+                continue;
+            }
+            const int score = outcome == WIN ? 1 : (outcome == DRAW ? 0 : -1);
+            results[start + i] = {static_cast<std::int8_t>(entry & 0x0F), static_cast<std::int8_t>(score)};
+        }
+    }
+}
+}
@@ -0,0 +1,48 @@
+#ifndef SOLVEDTABLE_H
+#define SOLVEDTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "board.h"
+
+// Perfect-play table for the standard 3x3 game (X moves first).
+// Every reachable position is solved once at compile time, so a lookup replaces the whole search.
+// The table is indexed by the raw position key, not the D4 canonical form (Board::canonicalForm): the key is
+// the array index, so a lookup is a single load. Keying by canonical form would cut the 19 KB table (one byte
+// per key) to the 765 positions distinct up to symmetry, but every lookup would then pay for eight
+// transforms, a search for the canonical key and mapping the move back.
+namespace SolvedTable {
+
+constexpr int POSITION_COUNT = 19683; // 3^9 base-3 keys
+
+// Game-theoretic value of a position for the side to move
+enum Outcome {
+    UNSOLVED = 0, // Terminal, unreachable, or not in the table
+    WIN,
+    DRAW,
+    LOSS
+};
+
+// Base-3 key of the position: digit (row * 3 + col) is 0 for empty, 1 for X and 2 for O
+int positionKey(const Board& board);
+
+// Side to move in a position reached from a normal game: X when both have played the same number of moves
+int sideToMove(const Board& board);
+
+// Best cell (row * 3 + col) for `player`, or -1 if the table cannot answer for this position/player
+int bestMove(const Board& board, int player);
+Outcome outcome(const Board& board);
+
+// Perfect-play answer for one packed position (Board::pack()), for the side to move
+struct Evaluation {
+    std::int8_t bestMove; // Cell (row * 3 + col); -1 if the game is over or the position cannot occur
+    std::int8_t score;    // 1 win, 0 draw, -1 loss
+};
+
+// Scores positions[0..count) into results. The side to move follows from the mark counts (X when they are
+// equal, as in the app), and positions from games O opened are looked up with the colours swapped.
+// Works in blocks, with a branch-free key pass the compiler can vectorize ahead of the table lookups.
+void evaluate(const Board::PackedPosition* positions, std::size_t count, Evaluation* results);
+}
+
+#endif // SOLVEDTABLE_H
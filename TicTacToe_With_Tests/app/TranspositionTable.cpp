@@ -0,0 +1,42 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+
+TranspositionTable::TranspositionTable(int sizeLog2)
+    : entries(std::size_t(1) << sizeLog2),
+    indexMask((quint64(1) << sizeLog2) - 1)
+{
+}
+
+const TranspositionTable::Entry* TranspositionTable::probe(Board::Hash key) {
+    ++counters.probes;
+    const Entry& entry = entries[key & indexMask];
+    if (entry.bound == NONE) {
+        ++counters.misses;
+        return nullptr;
+    }
+    if (entry.key != key) {
+        ++counters.collisions; // Another position owns this slot
+        return nullptr;
+    }
+    ++counters.hits;
+    return &entry;
+}
+
+void TranspositionTable::store(Board::Hash key, int score, int depth, int bestMove, Bound bound) {
+    Entry& entry = entries[key & indexMask];
+    // Keep a deeper result for the same position; anything else is replaced
+    if (entry.key == key && entry.bound != NONE && entry.depth > depth) {
+        return;
+    }
+    entry.key = key;
+    entry.score = static_cast<qint16>(score);
+    entry.depth = static_cast<qint8>(depth);
+    entry.bestMove = static_cast<qint8>(bestMove);
+    entry.bound = bound;
+    ++counters.stores;
+}
+
+void TranspositionTable::clear() {
+    std::fill(entries.begin(), entries.end(), Entry());
+    counters = Stats();
+}
@@ -0,0 +1,54 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <QtGlobal>
+#include <vector>
+#include "board.h"
+
+// Fixed-size, lossy cache of search results keyed by Zobrist hash.
+// Each slot holds one entry; a newer result for a different position simply overwrites it.
+class TranspositionTable
+{
+public:
+    // How the stored score relates to the true minimax value (alpha-beta bound type)
+    enum Bound : quint8 {
+        NONE = 0,
+        EXACT,
+        LOWER_BOUND, // Search failed high: true value >= score
+        UPPER_BOUND  // Search failed low:  true value <= score
+    };
+
+    struct Entry {
+        Board::Hash key = 0;
+        qint16 score = 0;
+        qint8 depth = 0;    // Remaining depth the score was searched to
+        qint8 bestMove = -1; // Cell index (row * 3 + col) of the best move found, -1 if none
+        Bound bound = NONE;
+    };
+
+    struct Stats {
+        quint64 probes = 0;
+        quint64 hits = 0;       // Slot held the probed position
+        quint64 misses = 0;     // Slot was empty
+        quint64 collisions = 0; // Slot held a different position
+        quint64 stores = 0;
+    };
+
+    explicit TranspositionTable(int sizeLog2 = 16);
+
+    // Returns the entry for this key, or nullptr if the slot holds nothing usable
+    const Entry* probe(Board::Hash key);
+    void store(Board::Hash key, int score, int depth, int bestMove, Bound bound);
+    void clear();
+
+    int size() const { return static_cast<int>(entries.size()); }
+    const Stats& stats() const { return counters; }
+    void resetStats() { counters = Stats(); }
+
+private:
+    std::vector<Entry> entries; // Allocated once; size is a power of two
+    quint64 indexMask;
+    Stats counters;
+};
+
+#endif // TRANSPOSITIONTABLE_H
@@ -0,0 +1,168 @@
+#include "WinKernel.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define WIN_KERNEL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define WIN_KERNEL_TARGET(isa) // MSVC accepts any intrinsic without a per-function target
+#else
+#define WIN_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace {
+
+constexpr std::uint32_t O_SHIFT = 9;
+constexpr std::uint32_t CELLS = Board::FULL_MASK;
+
+void classifyScalar(const Board::PackedPosition* positions, std::size_t count, std::uint8_t* status) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const Board::Mask x = static_cast<Board::Mask>(positions[i] & CELLS);
+        const Board::Mask o = static_cast<Board::Mask>((positions[i] >> O_SHIFT) & CELLS);
+        std::uint8_t flags = 0;
+        if (Board::hasLine(x)) flags |= WinKernel::X_LINE;
+        if (Board::hasLine(o)) flags |= WinKernel::O_LINE;
+        if ((x | o) == CELLS) flags |= WinKernel::FULL;
+        status[i] = flags;
+    }
+}
+
+#ifdef WIN_KERNEL_X86
+
+// 8 boards per iteration: one 32-bit lane each
+WIN_KERNEL_TARGET("avx2")
+void classifyAvx2(const Board::PackedPosition* positions, std::size_t count, std::uint8_t* status) {
+    const __m256i cells = _mm256_set1_epi32(CELLS);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i boards = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(positions + i));
+        const __m256i x = _mm256_and_si256(boards, cells);
+        const __m256i o = _mm256_and_si256(_mm256_srli_epi32(boards, O_SHIFT), cells);
+        __m256i xLine = _mm256_setzero_si256();
+        __m256i oLine = _mm256_setzero_si256();
+        for (Board::Mask mask : Board::WIN_MASKS) {
+            const __m256i line = _mm256_set1_epi32(mask);
+            xLine = _mm256_or_si256(xLine, _mm256_cmpeq_epi32(_mm256_and_si256(x, line), line));
+            oLine = _mm256_or_si256(oLine, _mm256_cmpeq_epi32(_mm256_and_si256(o, line), line));
+        }
+        const __m256i full = _mm256_cmpeq_epi32(_mm256_or_si256(x, o), cells);
+
+        // Each comparison lane is all ones or zero; keep one flag bit per lane and narrow to bytes
+        __m256i flags = _mm256_and_si256(xLine, _mm256_set1_epi32(WinKernel::X_LINE));
+        flags = _mm256_or_si256(flags, _mm256_and_si256(oLine, _mm256_set1_epi32(WinKernel::O_LINE)));
+        flags = _mm256_or_si256(flags, _mm256_and_si256(full, _mm256_set1_epi32(WinKernel::FULL)));
+        const __m128i low = _mm256_castsi256_si128(flags);
+        const __m128i high = _mm256_extracti128_si256(flags, 1);
+        const __m128i words = _mm_packus_epi32(low, high);
+        const __m128i bytes = _mm_packus_epi16(words, words);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(status + i), bytes);
+    }
+    classifyScalar(positions + i, count - i, status + i);
+}
+
+// 4 boards per iteration
+WIN_KERNEL_TARGET("sse4.1")
+void classifySse41(const Board::PackedPosition* positions, std::size_t count, std::uint8_t* status) {
+    const __m128i cells = _mm_set1_epi32(CELLS);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i boards = _mm_loadu_si128(reinterpret_cast<const __m128i*>(positions + i));
+        const __m128i x = _mm_and_si128(boards, cells);
+        const __m128i o = _mm_and_si128(_mm_srli_epi32(boards, O_SHIFT), cells);
+        __m128i xLine = _mm_setzero_si128();
+        __m128i oLine = _mm_setzero_si128();
+        for (Board::Mask mask : Board::WIN_MASKS) {
+            const __m128i line = _mm_set1_epi32(mask);
+            xLine = _mm_or_si128(xLine, _mm_cmpeq_epi32(_mm_and_si128(x, line), line));
+            oLine = _mm_or_si128(oLine, _mm_cmpeq_epi32(_mm_and_si128(o, line), line));
+        }
+        const __m128i full = _mm_cmpeq_epi32(_mm_or_si128(x, o), cells);
+
+        __m128i flags = _mm_and_si128(xLine, _mm_set1_epi32(WinKernel::X_LINE));
+        flags = _mm_or_si128(flags, _mm_and_si128(oLine, _mm_set1_epi32(WinKernel::O_LINE)));
+        flags = _mm_or_si128(flags, _mm_and_si128(full, _mm_set1_epi32(WinKernel::FULL)));
+        const __m128i words = _mm_packus_epi32(flags, flags);
+        const __m128i bytes = _mm_packus_epi16(words, words);
+        const std::uint32_t packed = static_cast<std::uint32_t>(_mm_cvtsi128_si32(bytes));
+        for (int lane = 0; lane < 4; ++lane) {
+            status[i + lane] = static_cast<std::uint8_t>(packed >> (8 * lane));
+        }
+    }
+    classifyScalar(positions + i, count - i, status + i);
+}
+
+bool cpuHas(WinKernel::Implementation implementation) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osSavesYmm) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+    return implementation == WinKernel::Implementation::Avx2 ? avx2 : sse41;
+#else
+    __builtin_cpu_init();
+    return implementation == WinKernel::Implementation::Avx2 ? __builtin_cpu_supports("avx2")
+                                                             : __builtin_cpu_supports("sse4.1");
+#endif
+}
+#endif // WIN_KERNEL_X86
+}
+
+namespace WinKernel {
+
+bool isSupported(Implementation implementation) {
+    if (implementation == Implementation::Scalar) {
+        return true;
+    }
+#ifdef WIN_KERNEL_X86
+    return cpuHas(implementation);
+#else
+    return false;
+#endif
+}
+
+Implementation bestImplementation() {
+    // Resolved once; the CPU does not change while the program runs
+    static const Implementation best = isSupported(Implementation::Avx2) ? Implementation::Avx2
+                                       : isSupported(Implementation::Sse41) ? Implementation::Sse41
+                                                                            : Implementation::Scalar;
+    return best;
+}
+
+const char* implementationName(Implementation implementation) {
+    switch (implementation) {
+    case Implementation::Avx2: return "avx2";
+    case Implementation::Sse41: return "sse4.1";
+    case Implementation::Scalar: break;
+    }
+    return "scalar";
+}
+
+void classify(const Board::PackedPosition* positions, std::size_t count, std::uint8_t* status) {
+    classify(bestImplementation(), positions, count, status);
+}
+
+void classify(Implementation implementation, const Board::PackedPosition* positions, std::size_t count,
+              std::uint8_t* status) {
+    switch (implementation) {
+#ifdef WIN_KERNEL_X86
+    case Implementation::Avx2:
+        classifyAvx2(positions, count, status);
+        return;
+    case Implementation::Sse41:
+        classifySse41(positions, count, status);
+        return;
+#endif
+    default:
+        classifyScalar(positions, count, status);
+        return;
+    }
+}
+}
@@ -0,0 +1,50 @@
+#ifndef WINKERNEL_H
+#define WINKERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include "board.h"
+
+// Win/draw status for many packed 3x3 boards (Board::pack()) at once.
+// Each lane of a SIMD register holds one board and is compared against all 8 line masks, so an AVX2
+// pass classifies 8 boards and an SSE4.1 pass 4. The best implementation the CPU supports is picked at
+// runtime; other CPUs and compilers use the scalar loop.
+namespace WinKernel {
+
+// Status bits for one board
+enum StatusFlag : std::uint8_t {
+    X_LINE = 1, // X has three in a row
+    O_LINE = 2, // O has three in a row
+    FULL = 4    // No empty cell left
+};
+
+enum class Implementation {
+    Scalar,
+    Sse41,
+    Avx2
+};
+
+// Writes a StatusFlag combination for each position, using the fastest supported implementation
+void classify(const Board::PackedPosition* positions, std::size_t count, std::uint8_t* status);
+
+// Same, with an explicit implementation (for tests and benchmarks); it must be supported
+void classify(Implementation implementation, const Board::PackedPosition* positions, std::size_t count,
+              std::uint8_t* status);
+
+bool isSupported(Implementation implementation);
+Implementation bestImplementation();
+const char* implementationName(Implementation implementation);
+
+// Board::checkWin() convention: PLAYER_X, PLAYER_O or EMPTY (X first if both have a line)
+inline int winner(std::uint8_t status) {
+    if (status & X_LINE) return Board::PLAYER_X;
+    if (status & O_LINE) return Board::PLAYER_O;
+    return Board::EMPTY;
+}
+
+inline bool isGameOver(std::uint8_t status) {
+    return status != 0;
+}
+}
+
+#endif // WINKERNEL_H
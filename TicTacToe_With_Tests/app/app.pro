@@ -1,6 +1,16 @@
 QT += core gui widgets sql
 CONFIG += c++17
 
+# SolvedTable.cpp solves every 3x3 position at compile time, which needs more than clang's and MSVC's default constexpr budget
+contains(QMAKE_COMPILER, clang) {
+    QMAKE_CXXFLAGS += -fconstexpr-steps=100000000
+} else:msvc {
+    QMAKE_CXXFLAGS += /constexpr:steps100000000
+}
+
+# Uncomment to compile the AI's search counters (SearchStats) out of the search loops
+# DEFINES += AI_SEARCH_STATS=0
+
 INCLUDEPATH += $$PWD/core \
                $$PWD/logic \
                $$PWD/database \
@@ -12,18 +22,43 @@ SOURCES += \
     main.cpp \
     mainwindow.cpp \
     Board.cpp \
+    AnyBoard.cpp \
+    GameCore.cpp \
     GameLogic.cpp \
     AIPlayer.cpp \
+    TranspositionTable.cpp \
+    ConcurrentTranspositionTable.cpp \
+    SolvedTable.cpp \
+    WinKernel.cpp \
     DatabaseManager.cpp \
+    DatabaseConnectionPool.cpp \
+    GameHistoryWriter.cpp \
+    GameHistoryModel.cpp \
     MessageBox.cpp
 
 
 HEADERS += \
     mainwindow.h \
     Board.h \
+    GridBoard.h \
+    AnyBoard.h \
+    GameCore.h \
+    GameRecord.h \
+    EloRating.h \
     GameLogic.h \
     AIPlayer.h \
+    TranspositionTable.h \
+    ConcurrentTranspositionTable.h \
+    SolvedTable.h \
+    WinKernel.h \
+    GridSearch.h \
+    MctsEngine.h \
+    SearchControl.h \
+    SearchStats.h \
     DatabaseManager.h \
+    DatabaseConnectionPool.h \
+    GameHistoryWriter.h \
+    GameHistoryModel.h \
     MessageBox.h
 
 RESOURCES += i18n.qrc
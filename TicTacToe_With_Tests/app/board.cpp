@@ -4,79 +4,214 @@ const int Board::EMPTY = 0;
 const int Board::PLAYER_X = 1;
 const int Board::PLAYER_O = -1;
 
+namespace {
+// splitmix64 step, used to fill the Zobrist table at compile time
+constexpr std::uint64_t splitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Keys [0..8] are for PLAYER_X, [9..17] for PLAYER_O
+constexpr std::array<Board::Hash, 18> makeZobristTable() {
+    std::array<Board::Hash, 18> table{};
+    std::uint64_t state = 0x54696354616354ULL; // Fixed seed so hashes are stable between runs
+    for (auto& key : table) {
+        key = splitMix64(state);
+    }
+    return table;
+}
+
+constexpr std::array<Board::Hash, 18> ZOBRIST_TABLE = makeZobristTable();
+
+// Where each cell goes under each of the 8 symmetries: reflect columns first for t >= 4, then rotate clockwise t % 4 times
+constexpr std::array<std::array<int, 9>, Board::SYMMETRY_COUNT> makeCellPermutations() {
+    std::array<std::array<int, 9>, Board::SYMMETRY_COUNT> permutations{};
+    for (int t = 0; t < Board::SYMMETRY_COUNT; ++t) {
+        for (int cell = 0; cell < 9; ++cell) {
+            int row = cell / 3;
+            int col = cell % 3;
+            if (t >= 4) {
+                col = 2 - col;
+            }
+            for (int turn = 0; turn < t % 4; ++turn) {
+                const int rotatedRow = col;
+                col = 2 - row;
+                row = rotatedRow;
+            }
+            permutations[t][cell] = row * 3 + col;
+        }
+    }
+    return permutations;
+}
+
+constexpr std::array<std::array<int, 9>, Board::SYMMETRY_COUNT> makeInversePermutations(
+    const std::array<std::array<int, 9>, Board::SYMMETRY_COUNT>& permutations) {
+    std::array<std::array<int, 9>, Board::SYMMETRY_COUNT> inverse{};
+    for (int t = 0; t < Board::SYMMETRY_COUNT; ++t) {
+        for (int cell = 0; cell < 9; ++cell) {
+            inverse[t][permutations[t][cell]] = cell;
+        }
+    }
+    return inverse;
+}
+
+// Every 9-bit mask pushed through every symmetry, so transforming a bitboard is one lookup
+constexpr std::array<std::array<Board::Mask, 512>, Board::SYMMETRY_COUNT> makeMaskPermutations(
+    const std::array<std::array<int, 9>, Board::SYMMETRY_COUNT>& permutations) {
+    std::array<std::array<Board::Mask, 512>, Board::SYMMETRY_COUNT> masks{};
+    for (int t = 0; t < Board::SYMMETRY_COUNT; ++t) {
+        for (int bits = 0; bits < 512; ++bits) {
+            int transformed = 0;
+            for (int cell = 0; cell < 9; ++cell) {
+                if (bits & (1 << cell)) {
+                    transformed |= 1 << permutations[t][cell];
+                }
+            }
+            masks[t][bits] = static_cast<Board::Mask>(transformed);
+        }
+    }
+    return masks;
+}
+
+constexpr std::array<std::array<int, 9>, Board::SYMMETRY_COUNT> CELL_PERMUTATIONS = makeCellPermutations();
+constexpr std::array<std::array<int, 9>, Board::SYMMETRY_COUNT> INVERSE_CELL_PERMUTATIONS =
+    makeInversePermutations(CELL_PERMUTATIONS);
+constexpr std::array<std::array<Board::Mask, 512>, Board::SYMMETRY_COUNT> MASK_PERMUTATIONS =
+    makeMaskPermutations(CELL_PERMUTATIONS);
+}
+
 Board::Board() {
     reset(); // Initialize the board when constructed
 }
 
 void Board::reset() {
     // Reset all cells to EMPTY
-    boardState.assign(3, std::vector<int>(3, EMPTY));
+    xMask = 0;
+    oMask = 0;
+    occupied = 0;
+    hash = 0;
 }
 
 bool Board::makeMove(int row, int col, int player) {
     // Check for valid move: within bounds and cell is empty
-    if (row >= 0 && row < 3 && col >= 0 && col < 3 && boardState[row][col] == EMPTY) {
-        boardState[row][col] = player; // Place the player's mark
-        return true; // Move successful
+    if (row < 0 || row >= 3 || col < 0 || col >= 3) {
+        return false; // Invalid move
+    }
+    const Mask bit = static_cast<Mask>(1u << (row * 3 + col));
+    if (occupied & bit) {
+        return false; // Cell already taken
+    }
+
+    if (player == PLAYER_X) {
+        xMask |= bit;
+    } else if (player == PLAYER_O) {
+        oMask |= bit;
+    } else {
+        return false; // Not a player value
+    }
+    occupied |= bit; // Place the player's mark
+    hash ^= zobristKey(player, row * 3 + col);
+    return true; // Move successful
+}
+
+void Board::undoMove(int row, int col) {
+    if (row < 0 || row >= 3 || col < 0 || col >= 3) {
+        return;
+    }
+    const int cell = row * 3 + col;
+    const Mask bit = static_cast<Mask>(1u << cell);
+    if (xMask & bit) {
+        hash ^= zobristKey(PLAYER_X, cell);
+    } else if (oMask & bit) {
+        hash ^= zobristKey(PLAYER_O, cell);
     }
-    return false; // Invalid move
+    const Mask keep = static_cast<Mask>(~bit);
+    xMask &= keep;
+    oMask &= keep;
+    occupied &= keep;
 }
 
 int Board::getCell(int row, int col) const {
     // Return the value of a cell if within bounds
     if (row >= 0 && row < 3 && col >= 0 && col < 3) {
-        return boardState[row][col];
+        const Mask bit = static_cast<Mask>(1u << (row * 3 + col));
+        if (xMask & bit) return PLAYER_X;
+        if (oMask & bit) return PLAYER_O;
     }
-    return EMPTY; // Return EMPTY for out-of-bounds access
+    return EMPTY; // Empty cell or out-of-bounds access
 }
 
 bool Board::isFull() const {
-    // Check if all cells are occupied
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (boardState[i][j] == EMPTY) {
-                return false; // Found an empty cell, so board is not full
-            }
-        }
-    }
-    return true; // All cells are occupied
+    // All 9 occupancy bits set means no empty cell is left
+    return occupied == FULL_MASK;
 }
 
 int Board::checkWin() const {
-    // Check rows for a win
-    for (int r = 0; r < 3; ++r) {
-        if (boardState[r][0] != EMPTY &&
-            boardState[r][0] == boardState[r][1] &&
-            boardState[r][1] == boardState[r][2]) {
-            return boardState[r][0]; // Return the winning player
-        }
+    // Test each player's bitboard against the 8 precomputed winning lines
+    if (hasLine(xMask)) {
+        return PLAYER_X;
     }
+    if (hasLine(oMask)) {
+        return PLAYER_O;
+    }
+    return EMPTY; // No winner yet
+}
 
-    // Check columns for a win
-    for (int c = 0; c < 3; ++c) {
-        if (boardState[0][c] != EMPTY &&
-            boardState[0][c] == boardState[1][c] &&
-            boardState[1][c] == boardState[2][c]) {
-            return boardState[0][c]; // Return the winning player
+Board::Hash Board::zobristKey(int player, int cell) {
+    return ZOBRIST_TABLE[(player == PLAYER_X ? 0 : 9) + cell];
+}
+
+Board::CanonicalForm Board::canonicalForm() const {
+    CanonicalForm best{pack(), 0};
+    for (int t = 1; t < SYMMETRY_COUNT; ++t) {
+        const PackedPosition key = PackedPosition(MASK_PERMUTATIONS[t][xMask]) |
+                                   (PackedPosition(MASK_PERMUTATIONS[t][oMask]) << 9);
+        if (key < best.key) {
+            best.key = key;
+            best.transform = t;
         }
     }
+    return best;
+}
 
-    // Check main diagonal for a win
-    if (boardState[0][0] != EMPTY &&
-        boardState[0][0] == boardState[1][1] &&
-        boardState[1][1] == boardState[2][2]) {
-        return boardState[0][0]; // Return the winning player
-    }
-    // Check anti-diagonal for a win
-    if (boardState[0][2] != EMPTY &&
-        boardState[0][2] == boardState[1][1] &&
-        boardState[1][1] == boardState[2][0]) {
-        return boardState[0][2]; // Return the winning player
-    }
+Board::Mask Board::transformMask(Mask bits, int transform) {
+    return MASK_PERMUTATIONS[transform][bits & FULL_MASK];
+}
 
-    return EMPTY; // No winner yet
+int Board::transformCell(int cell, int transform) {
+    return CELL_PERMUTATIONS[transform][cell];
+}
+
+int Board::inverseTransformCell(int cell, int transform) {
+    return INVERSE_CELL_PERMUTATIONS[transform][cell];
+}
+
+Board::Mask Board::getPlayerMask(int player) const {
+    if (player == PLAYER_X) return xMask;
+    if (player == PLAYER_O) return oMask;
+    return 0;
 }
 
 std::vector<std::vector<int>> Board::getBoardState() const {
-    return boardState; // Return a copy of the current board state
+    // Expand the bitboards into a 2D copy of the current board state
+    std::vector<std::vector<int>> state(3, std::vector<int>(3, EMPTY));
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            state[r][c] = getCell(r, c);
+        }
+    }
+    return state;
+}
+
+Board Board::fromBoardState(const std::vector<std::vector<int>>& state) {
+    // Rebuild a board from a 2D copy (the inverse of getBoardState)
+    Board board;
+    for (int r = 0; r < 3 && r < static_cast<int>(state.size()); ++r) {
+        for (int c = 0; c < 3 && c < static_cast<int>(state[r].size()); ++c) {
+            board.makeMove(r, c, state[r][c]);
+        }
+    }
+    return board;
 }
@@ -1,8 +1,9 @@
 #ifndef BOARD_H
 #define BOARD_H
 
-#include <QPoint>
-#include <vector> // Using std::vector for the board internal representation
+#include <array>
+#include <cstdint>
+#include <vector> // Only used by getBoardState() for callers that want a 2D copy
 
 class Board {
 public:
@@ -11,18 +12,82 @@ public:
     static const int PLAYER_X ;
     static const int PLAYER_O ;
 
+    // Board geometry, matching GridBoard so generic code can treat the classic board as N = 3, K = 3
+    static constexpr int SIZE = 3;
+    static constexpr int WIN_LENGTH = 3;
+    static constexpr int CELL_COUNT = 9;
+
+    // Bitboard layout: bit (row * 3 + col) represents one cell.
+    using Mask = std::uint16_t;
+    static constexpr Mask FULL_MASK = 0x1FF;
+
+    // The 8 winning lines: 3 rows, 3 columns and the 2 diagonals.
+    static constexpr std::array<Mask, 8> WIN_MASKS = {{
+        0x007, 0x038, 0x1C0, // Rows
+        0x049, 0x092, 0x124, // Columns
+        0x111, 0x054         // Main and anti-diagonal
+    }};
+
     Board();
     void reset();
     bool makeMove(int row, int col, int player);
+    void undoMove(int row, int col); // Clears a cell again; used by the AI to search in place
     int getCell(int row, int col) const;
     bool isFull() const;
     int checkWin() const; // Returns PLAYER_X, PLAYER_O, or EMPTY for no win/draw
 
+    // Zobrist hash of the position, updated incrementally by makeMove/undoMove/reset
+    using Hash = std::uint64_t;
+    Hash getHash() const { return hash; }
+    static Hash zobristKey(int player, int cell);
+
+    // Raw bitboards, used by the AI and by anything that needs to hash or pack a position
+    Mask getPlayerMask(int player) const;
+    Mask getOccupiedMask() const { return occupied; }
+
+    // True if the given player bitboard contains a complete line
+    static constexpr bool hasLine(Mask bits) {
+        for (Mask line : WIN_MASKS) {
+            if ((bits & line) == line) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Symmetry canonicalization over the 8 rotations/reflections of the board (the D4 group).
+    // Transform t maps cell c to transformCell(c, t); t = 0 is the identity.
+    static constexpr int SYMMETRY_COUNT = 8;
+    using PackedPosition = std::uint32_t; // xMask | (oMask << 9)
+
+    struct CanonicalForm {
+        PackedPosition key; // Smallest packed position among all 8 transforms
+        int transform;      // Transform that maps this board onto key
+    };
+
+    PackedPosition pack() const { return PackedPosition(xMask) | (PackedPosition(oMask) << 9); }
+    CanonicalForm canonicalForm() const;
+    static Mask transformMask(Mask bits, int transform);
+    static int transformCell(int cell, int transform);
+    static int inverseTransformCell(int cell, int transform); // Maps a canonical move back onto this board
+
+    static constexpr int countCells(Mask bits) {
+        int count = 0;
+        for (; bits; bits &= bits - 1) {
+            ++count;
+        }
+        return count;
+    }
+
     // For AI calculations (provides a copy of the internal state)
     std::vector<std::vector<int>> getBoardState() const;
+    static Board fromBoardState(const std::vector<std::vector<int>>& state);
 
 private:
-    std::vector<std::vector<int>> boardState; // The 3x3 game board
+    Mask xMask;    // Cells taken by PLAYER_X
+    Mask oMask;    // Cells taken by PLAYER_O
+    Mask occupied; // xMask | oMask, kept separately so isFull() is a single compare
+    Hash hash;     // XOR of zobristKey(player, cell) over all occupied cells
 };
 
 #endif // BOARD_H
@@ -2,45 +2,56 @@
 #define GAMELOGIC_H
 
 #include "board.h"
+#include "AnyBoard.h"
+#include "GameCore.h"
+#include "GameRecord.h"
+#include <QMetaType>
 #include <QObject>
 #include <QPoint>
-#include <QStringList>
 
 class AIPlayer;
 
+// Qt front end for GameCore: forwards moves to it, turns the results into signals for the UI and asks the
+// AIPlayer for moves when playing against it
 class GameLogic : public QObject {
     Q_OBJECT
 
 public:
     explicit GameLogic(QObject *parent = nullptr);
-    void startGame(bool vsAI, const QString& aiDifficulty);
+    // The main window's game page is a fixed 3x3 button grid, so it always plays Classic3x3. The larger
+    // variants are engine-only for now and are played by the self-play harness, the benchmarks and the tests.
+    void startGame(bool vsAI, const QString& aiDifficulty, BoardVariant variant = BoardVariant::Classic3x3);
     bool handlePlayerMove(int row, int col);
     void resetGame();
+    void cancelAiMove(); // Stops a pending AI move, e.g. when the player leaves the game page
     int getCurrentPlayer() const;
-    QStringList getMoveHistory() const;
+    const GameRecord& getMoveHistory() const; // Moves of the current (or just finished) game
     int getWinner() const;
     bool isVsAI() const; // Add this getter
+    QString getAiDifficulty() const; // Of the current game; empty when not playing the AI
+    BoardVariant getBoardVariant() const;
+    AIPlayer* getAIPlayer() const; // For tuning search limits and the presentation delay
 
 signals:
     void boardChanged(int row, int col, int player);
-    void gameEnded(const QString& winner, const QStringList& moves);
+    void gameEnded(const QString& winner, const GameRecord& moves);
     void currentPlayerChanged(int player);
-    void aiMoveRequested(const Board& currentBoard, const QString& difficulty);
+    void aiMoveRequested(const AnyBoard& currentBoard, const QString& difficulty);
+    void ponderRequested(const AnyBoard& currentBoard, const QString& difficulty); // Human to move after the AI
 
 private slots:
     void onAiMoveDetermined(const QPoint& move);
 
 private:
-    Board gameBoard;
+    GameCore core; // Board, turn and move list; classic 3x3 unless startGame picked a larger variant
     AIPlayer *aiPlayer;
-    int currentPlayer;
     bool vsAI; // This is the flag we need to access
     QString aiDifficulty;
-    QStringList moveHistory;
 
-    void switchPlayer();
+    GameCore::MoveResult applyMove(int row, int col);
     void processGameEnd(int winner);
-    void recordMove(int row, int col, int player);
 };
 
+Q_DECLARE_METATYPE(GameRecord)
+
 #endif // GAMELOGIC_H
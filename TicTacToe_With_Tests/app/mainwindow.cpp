@@ -2,6 +2,8 @@
 #include "ui_mainwindow.h"
 
 #include "DatabaseManager.h"
+#include "GameHistoryModel.h"
+#include "GameHistoryWriter.h"
 #include "gamelogic.h"
 #include "board.h"
 #include "messagebox.h"
@@ -11,7 +13,6 @@
 #include <QDateTime>
 #include <QDebug>
 #include <QPushButton>
-#include <QListWidgetItem>
 #include <QSettings>
 #include <QTimer>
 #include <QIcon>
@@ -29,6 +30,9 @@ MainWindow::MainWindow(QWidget *parent)
     ui->setupUi(this);
 
     dbManager = new DatabaseManager(this);
+    historyWriter = new GameHistoryWriter(dbManager->databaseFileName(), this); // Writes what is still queued when the window is destroyed
+    historyModel = new GameHistoryModel(dbManager, this);
+    ui->gameHistoryListView->setModel(historyModel);
     gameLogic = new GameLogic(this);
 
     setupConnections();
@@ -110,6 +114,10 @@ void MainWindow::setupConnections()
     connect(gameLogic, &GameLogic::gameEnded, this, &MainWindow::onGameEnded);
     connect(gameLogic, &GameLogic::currentPlayerChanged, this, &MainWindow::onCurrentPlayerChanged);
 
+    // --- History Writer Connections (emitted on the writer's thread, so queued to this one) ---
+    connect(historyWriter, &GameHistoryWriter::gamesSaved, this, &MainWindow::onHistoryGamesSaved);
+    connect(historyWriter, &GameHistoryWriter::gamesFailed, this, &MainWindow::onHistoryGamesFailed);
+
     // --- Replay Timer Connection ---
     connect(replayTimer, &QTimer::timeout, this, &MainWindow::replayNextMove);
 }
@@ -323,6 +331,7 @@ void MainWindow::on_resetGameboardButton_clicked() {
 }
 
 void MainWindow::on_backButtonGamePage_clicked() {
+    gameLogic->cancelAiMove(); // Leaving the page abandons any AI move still being searched
     if (replayTimer->isActive()) {
         replayTimer->stop();
         replayMoves.clear();
@@ -353,6 +362,8 @@ void MainWindow::on_startGameButton_clicked()
         aiDifficulty = "easy";
     } else if (ui->mediumRadioButton->isChecked()) {
         aiDifficulty = "medium";
+    } else if (ui->mctsRadioButton->isChecked()) {
+        aiDifficulty = "mcts";
     } else {
         aiDifficulty = "hard";
     }
@@ -390,48 +401,55 @@ void MainWindow::handleBoardClick() {
 void MainWindow::on_myAccountButton_clicked() {
     QVariantMap userInfo = dbManager->getUserInfo(currentUser);
     updateAccountInfoUI(userInfo);
+    updateAccountStatsUI(); // Games still on their way to the database are counted when they land
     ui->stackedWidget->setCurrentWidget(ui->page_4_personal_info);
 }
 
+void MainWindow::updateAccountStatsUI() {
+    const UserStats stats = dbManager->getUserStats(currentUser); // Kept up to date as games are saved; no history scan
+    ui->accountRecordLabel->setText(QString("%1 wins, %2 losses, %3 draws (%4 games)")
+                                        .arg(stats.wins)
+                                        .arg(stats.losses)
+                                        .arg(stats.draws)
+                                        .arg(stats.games));
+    const PlayerRating rating = dbManager->getRating(currentUser);
+    ui->accountRatingLabel->setText(QString("%1 (%2 rated games)").arg(qRound(rating.rating)).arg(rating.games));
+}
+
 void MainWindow::on_myGameHistoryButton_clicked() {
     ui->stackedWidget->setCurrentWidget(ui->page_6_game_history);
     loadGameHistoryUI();
 }
 
 void MainWindow::loadGameHistoryUI() {
-    ui->gameHistoryListWidget->clear();
-    QList<QVariantMap> history = dbManager->loadGameHistory(currentUser);
+    // Games finished moments ago may still be on their way to the database; onHistoryGamesSaved reloads then
+    historyModel->setUser(currentUser); // The view fetches the first page, and more as it is scrolled
+}
 
-    if (history.isEmpty()) {
-        ui->gameHistoryListWidget->addItem("No game history available.");
-        return;
+void MainWindow::onHistoryGamesSaved() {
+    // Refresh whichever page shows saved games, rather than making the GUI wait for the writer
+    if (ui->stackedWidget->currentWidget() == ui->page_6_game_history) {
+        loadGameHistoryUI();
+    } else if (ui->stackedWidget->currentWidget() == ui->page_4_personal_info) {
+        updateAccountStatsUI();
     }
+}
 
-    for (const QVariantMap& item : history) {
-        QString opponent = (item["player1"].toString() == currentUser) ? item["player2"].toString() : item["player1"].toString();
-        QString entry = QString("vs %1 | Result: %2 | On: %3")
-                            .arg(opponent)
-                            .arg(item["result"].toString())
-                            .arg(item["timestamp"].toDateTime().toString("yyyy-MM-dd hh:mm"));
-        QListWidgetItem *listItem = new QListWidgetItem(entry, ui->gameHistoryListWidget);
-        listItem->setData(Qt::UserRole, item["id"].toInt());
-    }
+void MainWindow::onHistoryGamesFailed(int count) {
+    Utils::showStyledMessageBox(this, "Error", QString("%1 finished game(s) could not be saved to your history.").arg(count), true);
 }
 
 void MainWindow::on_deleteGameButton_clicked() {
-    QListWidgetItem *selectedItem = ui->gameHistoryListWidget->currentItem();
-    if (selectedItem) {
-        int gameId = selectedItem->data(Qt::UserRole).toInt();
+    const QModelIndex selectedItem = ui->gameHistoryListView->currentIndex();
+    if (selectedItem.isValid()) {
+        int gameId = historyModel->gameId(selectedItem.row());
         QMessageBox::StandardButton reply;
         reply = QMessageBox::question(this, "Confirm Delete", "Are you sure you want to delete this game history?",
                                       QMessageBox::Yes|QMessageBox::No);
         if (reply == QMessageBox::Yes) {
             if (dbManager->deleteGameHistory(gameId)) {
-                delete selectedItem;
+                historyModel->removeGame(selectedItem.row());
                 Utils::showStyledMessageBox(this, "Success", "Game history deleted.");
-                if (ui->gameHistoryListWidget->count() == 0) {
-                    ui->gameHistoryListWidget->addItem("No game history available.");
-                }
             } else {
                 Utils::showStyledMessageBox(this, "Error", "Failed to delete game history.", true);
             }
@@ -446,15 +464,12 @@ void MainWindow::on_backButtonHistory_clicked() {
 }
 
 void MainWindow::replayNextMove() {
-    if (replayIndex < replayMoves.size()) {
-        QStringList parts = replayMoves[replayIndex].split(":");
-        int row = parts[0].toInt();
-        int col = parts[1].toInt();
-        QString playerChar = parts[2];
-        QPushButton *button = getButton(row, col);
+    if (replayIndex < static_cast<int>(replayMoves.size())) {
+        const MoveRecord move = replayMoves[replayIndex];
+        QPushButton *button = getButton(move.row, move.col);
         if(button) {
-            button->setText(playerChar);
-            if(playerChar == 'X') button->setStyleSheet("color: #89b4fa;"); // Use dark theme blue
+            button->setText((move.player == Board::PLAYER_X) ? "X" : "O");
+            if(move.player == Board::PLAYER_X) button->setStyleSheet("color: #89b4fa;"); // Use dark theme blue
             else button->setStyleSheet("color: #f38ba8;"); // Use dark theme red
         }
         replayIndex++;
@@ -466,13 +481,13 @@ void MainWindow::replayNextMove() {
 }
 
 void MainWindow::on_replayGameButton_clicked() {
-    QListWidgetItem *selectedItem = ui->gameHistoryListWidget->currentItem();
-    if (selectedItem) {
-        int gameId = selectedItem->data(Qt::UserRole).toInt();
-        QString movesString = dbManager->getGameMoves(gameId);
-        if (!movesString.isEmpty()) {
+    const QModelIndex selectedItem = ui->gameHistoryListView->currentIndex();
+    if (selectedItem.isValid()) {
+        int gameId = historyModel->gameId(selectedItem.row());
+        GameRecord moves = dbManager->getGameRecord(gameId);
+        if (!moves.empty()) {
             m_isReplayMode = true;
-            replayMoves = movesString.split(",");
+            replayMoves = moves;
             resetBoardUI();
             disableGameboardUI();
             replayIndex = 0;
@@ -496,11 +511,13 @@ void MainWindow::onBoardChanged(int row, int col, int player) {
     }
 }
 
-void MainWindow::onGameEnded(const QString& winner, const QStringList& moves) {
+void MainWindow::onGameEnded(const QString& winner, const GameRecord& moves) {
     if (!m_isReplayMode) {
-        Utils::showStyledMessageBox(this, "Game Over", winner);
+        // The opponent is saved as "AI" whatever the difficulty; each difficulty is still rated as a player of its own
         QString player2Name = gameLogic->isVsAI() ? "AI" : "Player O";
-        dbManager->saveGameHistory(currentUser, player2Name, winner, moves);
+        QString aiDifficulty = gameLogic->isVsAI() ? gameLogic->getAiDifficulty() : QString();
+        historyWriter->enqueue({currentUser, player2Name, winner, moves, aiDifficulty}); // Saved on the writer's thread
+        Utils::showStyledMessageBox(this, "Game Over", winner);
     }
     disableGameboardUI();
 }
@@ -3,12 +3,15 @@
 
 #include <QWidget>
 #include <QVariantMap>
+#include "GameRecord.h"
 
 // Forward declarations
 namespace Ui {
 class MainWindow;
 }
 class DatabaseManager;
+class GameHistoryModel;
+class GameHistoryWriter;
 class GameLogic;
 class QPushButton;
 class QLineEdit;
@@ -55,12 +58,15 @@ private slots:
     void handleBoardClick();
     void replayNextMove();
     void onBoardChanged(int row, int col, int player);
-    void onGameEnded(const QString& winner, const QStringList& moves);
+    void onGameEnded(const QString& winner, const GameRecord& moves);
     void onCurrentPlayerChanged(int player);
+    void onHistoryGamesSaved();
+    void onHistoryGamesFailed(int count);
 
 private:
     void setupConnections();
     void updateAccountInfoUI(const QVariantMap& userInfo);
+    void updateAccountStatsUI();
     void loadGameHistoryUI();
     void resetBoardUI();
     QPushButton* getButton(int row, int col);
@@ -70,11 +76,13 @@ private:
 
     Ui::MainWindow *ui;
     DatabaseManager *dbManager;
+    GameHistoryWriter *historyWriter;
+    GameHistoryModel *historyModel; // Behind gameHistoryListView
     GameLogic *gameLogic;
     // REMOVED: EmailManager *emailManager;
     QString currentUser;
     QTimer *replayTimer;
-    QStringList replayMoves;
+    GameRecord replayMoves;
     int replayIndex;
     bool isMessageBoxActive;
     bool m_loginInProgress;
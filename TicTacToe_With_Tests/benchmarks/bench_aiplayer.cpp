@@ -0,0 +1,104 @@
+#include "bench_aiplayer.h"
+#include "AIPlayer.h"
+#include "GameCore.h"
+
+namespace {
+// Fixed work per move instead of a time budget, so every run searches the same tree
+constexpr quint64 NODE_BUDGET = 20000;
+constexpr quint64 SEED = 1;
+
+void configure(AIPlayer& ai)
+{
+    SearchLimits limits;
+    limits.nodeBudget = NODE_BUDGET;
+    ai.setSearchLimits(limits);
+    ai.setPresentationDelay(0);
+    ai.setPonderingEnabled(false);
+    ai.setRandomSeed(SEED);
+}
+}
+
+void BenchAIPlayer::benchmarkFindBestMove_data()
+{
+    // Hard's reply to every opening move, and its own opening move
+    QTest::addColumn<int>("openingCell"); // -1: the AI moves first
+    QTest::newRow("ai opens") << -1;
+    for (int cell = 0; cell < 9; ++cell) {
+        QTest::newRow(qPrintable(QString("x at %1,%2").arg(cell / 3).arg(cell % 3))) << cell;
+    }
+}
+
+void BenchAIPlayer::benchmarkFindBestMove()
+{
+    QFETCH(int, openingCell);
+    AIPlayer ai;
+    configure(ai);
+    AnyBoard board;
+    if (openingCell >= 0) {
+        board.makeMove(openingCell / 3, openingCell % 3, Board::PLAYER_X);
+    }
+    const int player = openingCell >= 0 ? Board::PLAYER_O : Board::PLAYER_X;
+    QPoint move;
+    QBENCHMARK {
+        move = ai.computeMove(board, "hard", player);
+    }
+    QCOMPARE(board.getCell(move.x(), move.y()), Board::EMPTY);
+}
+
+void BenchAIPlayer::benchmarkGridSearch_data()
+{
+    QTest::addColumn<int>("variant");
+    QTest::addColumn<QString>("difficulty");
+    QTest::newRow("4x4 hard") << int(BoardVariant::Grid4x4) << "hard";
+    QTest::newRow("5x5 hard") << int(BoardVariant::Grid5x5) << "hard";
+    QTest::newRow("15x15 hard") << int(BoardVariant::Gomoku15x15) << "hard";
+    QTest::newRow("4x4 mcts") << int(BoardVariant::Grid4x4) << "mcts";
+    QTest::newRow("15x15 mcts") << int(BoardVariant::Gomoku15x15) << "mcts";
+}
+
+void BenchAIPlayer::benchmarkGridSearch()
+{
+    QFETCH(int, variant);
+    QFETCH(QString, difficulty);
+    AnyBoard board{static_cast<BoardVariant>(variant)};
+    const int centre = board.size() / 2;
+    board.makeMove(centre, centre, Board::PLAYER_X);
+
+    QPoint move;
+    QBENCHMARK {
+        AIPlayer ai; // Fresh tables and tree every time, so each iteration does the same search
+        configure(ai);
+        move = ai.computeMove(board, difficulty);
+    }
+    QCOMPARE(board.getCell(move.x(), move.y()), Board::EMPTY);
+}
+
+void BenchAIPlayer::benchmarkFullGame_data()
+{
+    QTest::addColumn<QString>("difficulty");
+    QTest::newRow("easy") << "easy";
+    QTest::newRow("medium") << "medium";
+    QTest::newRow("hard") << "hard";
+}
+
+void BenchAIPlayer::benchmarkFullGame()
+{
+    // Whole 3x3 games, the AI playing both sides through GameCore: the self-play hot loop
+    QFETCH(QString, difficulty);
+    AIPlayer ai;
+    configure(ai);
+    GameCore core;
+    int games = 0;
+    QBENCHMARK {
+        core.reset();
+        while (!core.isOver()) {
+            const QPoint move = ai.computeMove(core.getBoard(), difficulty, core.getCurrentPlayer());
+            if (core.playMove(move.x(), move.y()) == GameCore::MoveResult::Invalid) {
+                break;
+            }
+        }
+        ++games;
+    }
+    QVERIFY(core.isOver());
+    QVERIFY(games > 0);
+}
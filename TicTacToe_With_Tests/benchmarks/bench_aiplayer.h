@@ -0,0 +1,20 @@
+#ifndef BENCH_AIPLAYER_H
+#define BENCH_AIPLAYER_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class BenchAIPlayer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void benchmarkFindBestMove_data();
+    void benchmarkFindBestMove();
+    void benchmarkGridSearch_data();
+    void benchmarkGridSearch();
+    void benchmarkFullGame_data();
+    void benchmarkFullGame();
+};
+
+#endif // BENCH_AIPLAYER_H
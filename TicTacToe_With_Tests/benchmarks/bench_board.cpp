@@ -0,0 +1,105 @@
+#include "bench_board.h"
+#include "board.h"
+
+namespace {
+
+// Row-major cells: 'X', 'O' or '.'
+Board boardFromCells(const QString& cells)
+{
+    Board board;
+    for (int cell = 0; cell < 9; ++cell) {
+        if (cells[cell] == 'X') {
+            board.makeMove(cell / 3, cell % 3, Board::PLAYER_X);
+        } else if (cells[cell] == 'O') {
+            board.makeMove(cell / 3, cell % 3, Board::PLAYER_O);
+        }
+    }
+    return board;
+}
+
+void addPositions()
+{
+    QTest::addColumn<QString>("cells");
+    QTest::newRow("empty") << ".........";
+    QTest::newRow("midgame") << "X.O.X.O..";
+    QTest::newRow("x wins") << "XXXOO....";
+    QTest::newRow("o wins diagonal") << "OXXXO.X.O";
+    QTest::newRow("draw") << "XOXXOOOXX";
+}
+
+// Positions cycled through by the copy benchmarks, so the compiler cannot hoist a single board out of the loop
+std::vector<Board> samplePositions()
+{
+    return {boardFromCells("........."), boardFromCells("X.O.X.O.."), boardFromCells("XXXOO...."),
+            boardFromCells("OXXXO.X.O"), boardFromCells("XOXXOOOXX")};
+}
+}
+
+void BenchBoard::benchmarkCheckWin_data()
+{
+    addPositions();
+}
+
+void BenchBoard::benchmarkCheckWin()
+{
+    QFETCH(QString, cells);
+    const Board board = boardFromCells(cells);
+    volatile int winner = Board::EMPTY; // Keeps the call from being optimized away
+    QBENCHMARK {
+        winner = board.checkWin();
+    }
+    Q_UNUSED(winner);
+}
+
+void BenchBoard::benchmarkIsFull_data()
+{
+    addPositions();
+}
+
+void BenchBoard::benchmarkIsFull()
+{
+    QFETCH(QString, cells);
+    const Board board = boardFromCells(cells);
+    volatile bool full = false;
+    QBENCHMARK {
+        full = board.isFull();
+    }
+    Q_UNUSED(full);
+}
+
+void BenchBoard::benchmarkGetBoardState()
+{
+    const std::vector<Board> positions = samplePositions();
+    std::size_t index = 0;
+    volatile int centre = Board::EMPTY;
+    QBENCHMARK {
+        const std::vector<std::vector<int>> state = positions[index++ % positions.size()].getBoardState();
+        centre = state[1][1];
+    }
+    Q_UNUSED(centre);
+}
+
+void BenchBoard::benchmarkFromBoardState()
+{
+    std::vector<std::vector<std::vector<int>>> states;
+    for (const Board& board : samplePositions()) {
+        states.push_back(board.getBoardState());
+    }
+    std::size_t index = 0;
+    volatile Board::Hash hash = 0;
+    QBENCHMARK {
+        hash = Board::fromBoardState(states[index++ % states.size()]).getHash();
+    }
+    Q_UNUSED(hash);
+}
+
+void BenchBoard::benchmarkCanonicalForm()
+{
+    const std::vector<Board> positions = samplePositions();
+    std::size_t index = 0;
+    volatile Board::PackedPosition keys = 0;
+    QBENCHMARK {
+        keys = positions[index++ % positions.size()].canonicalForm().key;
+    }
+    Q_UNUSED(keys);
+}
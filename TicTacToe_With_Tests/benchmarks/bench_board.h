@@ -0,0 +1,21 @@
+#ifndef BENCH_BOARD_H
+#define BENCH_BOARD_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class BenchBoard : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void benchmarkCheckWin_data();
+    void benchmarkCheckWin();
+    void benchmarkIsFull_data();
+    void benchmarkIsFull();
+    void benchmarkGetBoardState();
+    void benchmarkFromBoardState();
+    void benchmarkCanonicalForm();
+};
+
+#endif // BENCH_BOARD_H
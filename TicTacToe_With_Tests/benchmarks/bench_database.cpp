@@ -0,0 +1,148 @@
+#include "bench_database.h"
+#include "DatabaseManager.h"
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+namespace {
+const QString DATABASE_FILE = "bench_history.db";
+
+// The history rows are spread over this many players, so one player's history is 1% of the table
+constexpr int PLAYERS = 100;
+
+// A full 3x3 game: (1,1) (0,0) (0,2) (2,0) (1,0) (1,2) (0,1) (2,1) (2,2)
+GameRecord sampleMoves()
+{
+    GameRecord moves;
+    for (int cell : {4, 0, 2, 6, 3, 5, 1, 7, 8}) {
+        moves.appendCell(cell);
+    }
+    return moves;
+}
+
+void addTableSizes()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M") << 1000000;
+}
+}
+
+BenchDatabase::BenchDatabase() = default;
+BenchDatabase::~BenchDatabase() = default;
+
+void BenchDatabase::initTestCase()
+{
+    QFile::remove(DATABASE_FILE);
+    database = std::make_unique<DatabaseManager>(nullptr, DATABASE_FILE);
+}
+
+void BenchDatabase::cleanupTestCase()
+{
+    database.reset(); // Releases the connection
+    QFile::remove(DATABASE_FILE);
+}
+
+// Brings game_history to exactly `rows` generated rows: drops anything after the first `rows` (including games
+// saved by a benchmark), then tops up in one transaction. Row i always belongs to player(i % PLAYERS).
+void BenchDatabase::fillHistory(int rows)
+{
+    QSqlDatabase db = database->connection();
+    QSqlQuery trim(db);
+    trim.prepare("DELETE FROM game_history WHERE id > (SELECT id FROM game_history ORDER BY id LIMIT 1 OFFSET :last)");
+    trim.bindValue(":last", rows - 1);
+    QVERIFY(trim.exec());
+
+    QSqlQuery count(db);
+    QVERIFY(count.exec("SELECT COUNT(*) FROM game_history") && count.next());
+    const int existing = count.value(0).toInt();
+
+    const QByteArray moves = DatabaseManager::encodeMoves(sampleMoves());
+    QVERIFY(db.transaction());
+    QSqlQuery insert(db);
+    insert.prepare("INSERT INTO game_history (player1, player2, result, outcome, moves) VALUES (:p1, :p2, :r, :o, :m)");
+    for (int row = existing; row < rows; ++row) {
+        const QString result = row % 3 == 0 ? "Draw" : "AI wins!";
+        insert.bindValue(":p1", QString("player%1").arg(row % PLAYERS));
+        insert.bindValue(":p2", "AI");
+        insert.bindValue(":r", result);
+        insert.bindValue(":o", static_cast<int>(DatabaseManager::outcomeFromResult(result)));
+        insert.bindValue(":m", moves);
+        QVERIFY(insert.exec());
+    }
+    QVERIFY(db.commit());
+}
+
+void BenchDatabase::benchmarkSaveGameHistory_data()
+{
+    addTableSizes();
+}
+
+void BenchDatabase::benchmarkSaveGameHistory()
+{
+    QFETCH(int, rows);
+    fillHistory(rows);
+    const GameRecord moves = sampleMoves();
+    QBENCHMARK {
+        QVERIFY(database->saveGameHistory("player0", "AI", "Draw", moves));
+    }
+    fillHistory(rows); // Drops the games saved above
+}
+
+void BenchDatabase::benchmarkLoadGameHistory_data()
+{
+    addTableSizes();
+}
+
+void BenchDatabase::benchmarkLoadGameHistory()
+{
+    QFETCH(int, rows);
+    fillHistory(rows);
+    int loaded = 0;
+    QBENCHMARK {
+        loaded = database->loadGameHistory("player1").size();
+    }
+    QCOMPARE(loaded, rows / PLAYERS);
+}
+
+// Not a timing: at the largest size, checks SQLite still answers the history query from the two player
+// indexes, merging them rather than scanning the table or sorting
+void BenchDatabase::historyQueryUsesIndexes()
+{
+    fillHistory(1000000);
+    const QStringList plan = database->explainHistoryQuery("player1");
+    const QString details = plan.join('\n');
+    QVERIFY2(details.contains("USING INDEX game_history_player1"), qPrintable(details));
+    QVERIFY2(details.contains("USING INDEX game_history_player2"), qPrintable(details));
+    QVERIFY2(!details.contains("TEMP B-TREE"), qPrintable(details));
+    QVERIFY2(!details.contains("SCAN game_history"), qPrintable(details));
+}
+
+void BenchDatabase::benchmarkRecomputeRatings_data()
+{
+    addTableSizes();
+}
+
+void BenchDatabase::benchmarkRecomputeRatings()
+{
+    QFETCH(int, rows);
+    fillHistory(rows);
+    QBENCHMARK {
+        QVERIFY(database->recomputeRatings());
+    }
+    QCOMPARE(database->getRating("AI").games, rows); // Every generated game has a known outcome
+}
+
+// What a leaderboard page costs: the first rows of the ratings index, however many games are stored
+void BenchDatabase::benchmarkTopRatings()
+{
+    fillHistory(1000000);
+    QVERIFY(database->recomputeRatings());
+    int shown = 0;
+    QBENCHMARK {
+        shown = database->topRatings(10).size();
+    }
+    QCOMPARE(shown, 10);
+}
@@ -0,0 +1,37 @@
+#ifndef BENCH_DATABASE_H
+#define BENCH_DATABASE_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <memory>
+
+class DatabaseManager;
+
+class BenchDatabase : public QObject
+{
+    Q_OBJECT
+
+public:
+    BenchDatabase();
+    ~BenchDatabase();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkSaveGameHistory_data();
+    void benchmarkSaveGameHistory();
+    void benchmarkLoadGameHistory_data();
+    void benchmarkLoadGameHistory();
+    void historyQueryUsesIndexes();
+    void benchmarkRecomputeRatings_data();
+    void benchmarkRecomputeRatings();
+    void benchmarkTopRatings();
+
+private:
+    void fillHistory(int rows);
+
+    std::unique_ptr<DatabaseManager> database;
+};
+
+#endif // BENCH_DATABASE_H
@@ -0,0 +1,44 @@
+#include <QCoreApplication>
+#include <QDir>
+#include <QtTest>
+#include "bench_aiplayer.h"
+#include "bench_board.h"
+#include "bench_database.h"
+#include "bench_winkernel.h"
+
+// Runs every benchmark class in turn. Arguments are passed on to QTest (e.g. -iterations 1000, -median 5, or a
+// function name); "--csv DIR" also writes DIR/<Class>.csv for tracking results between releases.
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList arguments = app.arguments();
+    QString csvDirectory;
+    const int csvOption = arguments.indexOf("--csv");
+    if (csvOption > 0 && csvOption + 1 < arguments.size()) {
+        csvDirectory = arguments.at(csvOption + 1);
+        arguments.erase(arguments.begin() + csvOption, arguments.begin() + csvOption + 2);
+        QDir().mkpath(csvDirectory);
+    }
+
+    int status = 0;
+    auto run = [&](QObject* benchmarkClass) {
+        QStringList classArguments = arguments;
+        if (!csvDirectory.isEmpty()) {
+            const QString file = QDir(csvDirectory).filePath(QString(benchmarkClass->metaObject()->className()) + ".csv");
+            classArguments << "-o" << "-,txt" << "-o" << file + ",csv"; // Console and CSV
+        }
+        status |= QTest::qExec(benchmarkClass, classArguments);
+    };
+
+    BenchBoard board;
+    run(&board);
+    BenchWinKernel winKernel;
+    run(&winKernel);
+    BenchAIPlayer aiPlayer;
+    run(&aiPlayer);
+    BenchDatabase database;
+    run(&database);
+
+    return status;
+}
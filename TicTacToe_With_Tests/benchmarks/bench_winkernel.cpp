@@ -0,0 +1,68 @@
+#include "bench_winkernel.h"
+#include "WinKernel.h"
+#include <vector>
+
+namespace {
+
+// Every packed position where no cell holds both marks, as in the kernel's tests
+std::vector<Board::PackedPosition> allPositions()
+{
+    std::vector<Board::PackedPosition> positions;
+    for (Board::PackedPosition packed = 0; packed < (1u << 18); ++packed) {
+        if ((packed & Board::FULL_MASK & (packed >> 9)) == 0) {
+            positions.push_back(packed);
+        }
+    }
+    return positions;
+}
+
+Board unpack(Board::PackedPosition packed)
+{
+    Board board;
+    for (int cell = 0; cell < 9; ++cell) {
+        if (packed & (1u << cell)) {
+            board.makeMove(cell / 3, cell % 3, Board::PLAYER_X);
+        } else if (packed & (1u << (cell + 9))) {
+            board.makeMove(cell / 3, cell % 3, Board::PLAYER_O);
+        }
+    }
+    return board;
+}
+}
+
+void BenchWinKernel::benchmarkKernel_data()
+{
+    QTest::addColumn<int>("implementation");
+    for (WinKernel::Implementation implementation : {WinKernel::Implementation::Scalar, WinKernel::Implementation::Sse41,
+                                                      WinKernel::Implementation::Avx2}) {
+        if (WinKernel::isSupported(implementation)) {
+            QTest::newRow(WinKernel::implementationName(implementation)) << static_cast<int>(implementation);
+        }
+    }
+}
+
+void BenchWinKernel::benchmarkKernel()
+{
+    QFETCH(int, implementation);
+    const std::vector<Board::PackedPosition> positions = allPositions();
+    std::vector<std::uint8_t> status(positions.size());
+    QBENCHMARK {
+        WinKernel::classify(static_cast<WinKernel::Implementation>(implementation), positions.data(),
+                            positions.size(), status.data());
+    }
+}
+
+void BenchWinKernel::benchmarkCheckWin()
+{
+    // The same positions one Board at a time, as the game and the search check them
+    std::vector<Board> boards;
+    for (Board::PackedPosition packed : allPositions()) {
+        boards.push_back(unpack(packed));
+    }
+    std::vector<std::uint8_t> status(boards.size());
+    QBENCHMARK {
+        for (std::size_t i = 0; i < boards.size(); ++i) {
+            status[i] = static_cast<std::uint8_t>((boards[i].checkWin() != Board::EMPTY) | (boards[i].isFull() << 2));
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef BENCH_WINKERNEL_H
+#define BENCH_WINKERNEL_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class BenchWinKernel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void benchmarkKernel_data();
+    void benchmarkKernel();
+    void benchmarkCheckWin();
+};
+
+#endif // BENCH_WINKERNEL_H
@@ -0,0 +1,47 @@
+QT += testlib sql
+QT -= gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+TEMPLATE = app
+TARGET = benchmarks
+
+# SolvedTable.cpp solves every 3x3 position at compile time, which needs more than clang's and MSVC's default constexpr budget
+contains(QMAKE_COMPILER, clang) {
+    QMAKE_CXXFLAGS += -fconstexpr-steps=100000000
+} else:msvc {
+    QMAKE_CXXFLAGS += /constexpr:steps100000000
+}
+
+# Benchmarks are only meaningful for optimized builds
+CONFIG += release
+
+# The benchmarked code is compiled from the app's sources, like the tests do
+APP_DIR = ../app
+INCLUDEPATH += $$APP_DIR
+
+SOURCES += \
+    bench_main.cpp \
+    bench_board.cpp \
+    bench_winkernel.cpp \
+    bench_aiplayer.cpp \
+    bench_database.cpp
+
+SOURCES += \
+    $$APP_DIR/board.cpp \
+    $$APP_DIR/AnyBoard.cpp \
+    $$APP_DIR/GameCore.cpp \
+    $$APP_DIR/AIPlayer.cpp \
+    $$APP_DIR/TranspositionTable.cpp \
+    $$APP_DIR/ConcurrentTranspositionTable.cpp \
+    $$APP_DIR/SolvedTable.cpp \
+    $$APP_DIR/WinKernel.cpp \
+    $$APP_DIR/DatabaseManager.cpp \
+    $$APP_DIR/DatabaseConnectionPool.cpp
+
+HEADERS += \
+    bench_board.h \
+    bench_winkernel.h \
+    bench_aiplayer.h \
+    bench_database.h \
+    $$APP_DIR/AIPlayer.h \
+    $$APP_DIR/DatabaseManager.h
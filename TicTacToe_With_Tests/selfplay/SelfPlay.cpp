@@ -0,0 +1,175 @@
+#include "SelfPlay.h"
+#include "AIPlayer.h"
+#include "GameCore.h"
+#include "WinKernel.h"
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+
+namespace {
+// Games a worker claims at a time: large enough to keep the shared counter cold, small enough to balance
+constexpr int GAMES_PER_CLAIM = 8;
+
+// What one worker collected; merged into the report once it has run out of games
+struct WorkerTotals {
+    std::vector<PairingResult> results;
+    std::vector<std::vector<qint64>> latencies; // Per engine, one entry per move
+    std::vector<quint64> nodes;
+    quint64 games = 0;
+    quint64 invalidMoves = 0;
+    quint64 verdictMismatches = 0;
+};
+
+// Classifies every position a 3x3 game went through in one WinKernel batch and counts those where GameCore's
+// verdict (winner, or still in progress) differs, so the rules the engines were judged by are checked independently
+quint64 countVerdictMismatches(const Board::PackedPosition* positions, const int* verdicts, int count) {
+    std::uint8_t status[Board::SIZE * Board::SIZE];
+    WinKernel::classify(positions, std::size_t(count), status);
+    quint64 mismatches = 0;
+    for (int k = 0; k < count; ++k) {
+        const int expected = WinKernel::isGameOver(status[k]) ? WinKernel::winner(status[k]) : GameCore::IN_PROGRESS;
+        mismatches += (expected != verdicts[k]);
+    }
+    return mismatches;
+}
+
+// players are the worker's own, reused for every game it plays
+void playGame(const SelfPlayConfig& config, int pairing, int game, AIPlayer (&players)[2], WorkerTotals& totals) {
+    const int engineCount = config.engines.size();
+    const int engines[2] = {pairing / engineCount, pairing % engineCount}; // X, O
+
+    GameCore core(config.variant);
+    for (int side = 0; side < 2; ++side) {
+        players[side].setRandomSeed(SelfPlay::gameSeed(config.seed, pairing, game, side));
+        players[side].clearTables(); // Nothing carries over from the worker's previous game
+    }
+
+    Board::PackedPosition positions[Board::SIZE * Board::SIZE]; // After each move; 3x3 only
+    int verdicts[Board::SIZE * Board::SIZE];
+    int positionCount = 0;
+
+    int winner = Board::EMPTY;
+    while (!core.isOver()) {
+        const int mover = core.getCurrentPlayer();
+        const int side = (mover == Board::PLAYER_X) ? 0 : 1;
+        QElapsedTimer timer;
+        timer.start();
+        const QPoint move = players[side].computeMove(core.getBoard(), config.engines[engines[side]], mover);
+        totals.latencies[engines[side]].push_back(timer.nsecsElapsed());
+        totals.nodes[engines[side]] += players[side].lastSearchNodeCount();
+
+        if (core.playMove(move.x(), move.y()) == GameCore::MoveResult::Invalid) {
+            ++totals.invalidMoves;
+            winner = -mover; // An illegal move forfeits the game
+            break;
+        }
+        winner = core.getWinner();
+        if (const Board* classic = core.getBoard().classic()) {
+            positions[positionCount] = classic->pack();
+            verdicts[positionCount++] = winner;
+        }
+    }
+    totals.verdictMismatches += countVerdictMismatches(positions, verdicts, positionCount);
+
+    PairingResult& result = totals.results[pairing];
+    if (winner == Board::PLAYER_X) {
+        ++result.xWins;
+    } else if (winner == Board::PLAYER_O) {
+        ++result.oWins;
+    } else {
+        ++result.draws;
+    }
+    ++totals.games;
+}
+
+qint64 percentile(const std::vector<qint64>& sorted, int percent) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const std::size_t index = (sorted.size() - 1) * std::size_t(percent) / 100;
+    return sorted[index];
+}
+}
+
+quint64 SelfPlay::gameSeed(quint64 seed, int pairing, int game, int player) {
+    // splitmix64 over the game's coordinates, so neighbouring games get unrelated streams
+    quint64 z = seed ^ (quint64(pairing) << 40) ^ (quint64(game) << 8) ^ quint64(player & 0xFF);
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+SelfPlayReport SelfPlay::run(const SelfPlayConfig& config) {
+    const int engineCount = config.engines.size();
+    const int pairings = engineCount * engineCount;
+    const int totalGames = pairings * std::max(0, config.gamesPerPairing);
+    const int threads = config.threads > 0 ? config.threads : QThread::idealThreadCount();
+
+    SelfPlayReport report;
+    report.engines = config.engines;
+    report.results.resize(pairings);
+    report.timing.resize(engineCount);
+    std::vector<std::vector<qint64>> latencies(engineCount);
+
+    QElapsedTimer wallClock;
+    wallClock.start();
+    std::atomic<int> nextGame{0};
+    QMutex reportMutex;
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (int worker = 0; worker < threads; ++worker) {
+        pool.start([&]() {
+            WorkerTotals totals;
+            totals.results.resize(pairings);
+            totals.latencies.resize(engineCount);
+            totals.nodes.resize(engineCount);
+            AIPlayer players[2]; // Created once per worker: their tables and MCTS arenas are several MB each
+            for (AIPlayer& player : players) {
+                player.setPresentationDelay(0);
+                player.setPonderingEnabled(false);
+                player.setSearchLimits(config.limits);
+            }
+            for (int first = nextGame.fetch_add(GAMES_PER_CLAIM); first < totalGames;
+                 first = nextGame.fetch_add(GAMES_PER_CLAIM)) {
+                for (int index = first; index < std::min(first + GAMES_PER_CLAIM, totalGames); ++index) {
+                    playGame(config, index / config.gamesPerPairing, index % config.gamesPerPairing, players, totals);
+                }
+            }
+
+            QMutexLocker locker(&reportMutex);
+            for (int p = 0; p < pairings; ++p) {
+                report.results[p].xWins += totals.results[p].xWins;
+                report.results[p].draws += totals.results[p].draws;
+                report.results[p].oWins += totals.results[p].oWins;
+            }
+            for (int e = 0; e < engineCount; ++e) {
+                report.timing[e].nodes += totals.nodes[e];
+                latencies[e].insert(latencies[e].end(), totals.latencies[e].begin(), totals.latencies[e].end());
+            }
+            report.games += totals.games;
+            report.invalidMoves += totals.invalidMoves;
+            report.verdictMismatches += totals.verdictMismatches;
+        });
+    }
+    pool.waitForDone();
+    report.wallSeconds = wallClock.nsecsElapsed() / 1e9;
+
+    for (int e = 0; e < engineCount; ++e) {
+        std::vector<qint64>& moves = latencies[e];
+        std::sort(moves.begin(), moves.end());
+        EngineTiming& timing = report.timing[e];
+        timing.moves = moves.size();
+        for (qint64 nanoseconds : moves) {
+            timing.searchNanoseconds += nanoseconds;
+        }
+        timing.p50Nanoseconds = percentile(moves, 50);
+        timing.p90Nanoseconds = percentile(moves, 90);
+        timing.p99Nanoseconds = percentile(moves, 99);
+        timing.maxNanoseconds = moves.empty() ? 0 : moves.back();
+    }
+    return report;
+}
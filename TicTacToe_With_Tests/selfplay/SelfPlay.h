@@ -0,0 +1,60 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include <QStringList>
+#include <QtGlobal>
+#include <vector>
+#include "AnyBoard.h"
+#include "SearchControl.h"
+
+// Settings for one tournament
+struct SelfPlayConfig {
+    QStringList engines = {"easy", "medium", "hard", "mcts"}; // AIPlayer difficulties
+    int gamesPerPairing = 100; // Games for each (X engine, O engine) pair
+    BoardVariant variant = BoardVariant::Classic3x3;
+    SearchLimits limits;       // Per move; a node budget (and no time budget) keeps runs reproducible
+    int threads = 0;           // 0 = QThread::idealThreadCount()
+    quint64 seed = 1;          // Every game's seeds derive from this and the game's index
+};
+
+// Results of one (X engine, O engine) pair, from X's side
+struct PairingResult {
+    int xWins = 0;
+    int draws = 0;
+    int oWins = 0;
+};
+
+// Per-move cost of one engine over the whole tournament
+struct EngineTiming {
+    quint64 moves = 0;
+    quint64 nodes = 0;          // Search nodes or MCTS playouts; table answers count 0
+    qint64 searchNanoseconds = 0;
+    qint64 p50Nanoseconds = 0;  // Per-move latency percentiles
+    qint64 p90Nanoseconds = 0;
+    qint64 p99Nanoseconds = 0;
+    qint64 maxNanoseconds = 0;
+};
+
+struct SelfPlayReport {
+    QStringList engines;
+    std::vector<PairingResult> results; // results[x * engines.size() + o]: row engine plays X
+    std::vector<EngineTiming> timing;   // Indexed like engines
+    quint64 games = 0;
+    quint64 invalidMoves = 0;           // Moves an engine returned that the rules rejected (should stay 0)
+    quint64 verdictMismatches = 0;      // 3x3 positions where GameCore and WinKernel disagree on win/draw (should stay 0)
+    double wallSeconds = 0;
+};
+
+// Plays every engine against every engine (both colours, and itself) on a thread pool.
+// Each worker reuses two AIPlayers, reseeded from (seed, pairing, game) and cleared before every game, so the
+// outcome of a game does not depend on which thread ran it or what it played before; with node-only limits the
+// whole report except the timings is reproducible.
+class SelfPlay {
+public:
+    static SelfPlayReport run(const SelfPlayConfig& config);
+
+    // Seed of one side in one game; exposed so a single game can be replayed
+    static quint64 gameSeed(quint64 seed, int pairing, int game, int player);
+};
+
+#endif // SELFPLAY_H
@@ -0,0 +1,132 @@
+// Self-play tournament: every AI difficulty against every other, to check that engine work keeps its strength.
+//   selfplay --games 200 --board 4x4 --nodes 20000 --threads 8 --seed 7
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+#include "SelfPlay.h"
+
+namespace {
+
+bool parseVariant(const QString& name, BoardVariant& variant) {
+    if (name == "3x3") variant = BoardVariant::Classic3x3;
+    else if (name == "4x4") variant = BoardVariant::Grid4x4;
+    else if (name == "5x5") variant = BoardVariant::Grid5x5;
+    else if (name == "15x15") variant = BoardVariant::Gomoku15x15;
+    else return false;
+    return true;
+}
+
+QString microseconds(qint64 nanoseconds) {
+    return QString::number(nanoseconds / 1000.0, 'f', 1);
+}
+
+void printReport(const SelfPlayReport& report, const SelfPlayConfig& config, QTextStream& out) {
+    const int engineCount = report.engines.size();
+    int width = 8;
+    for (const QString& engine : report.engines) {
+        width = std::max(width, engine.size() + 2);
+    }
+    const int cellWidth = std::max(width, 16);
+
+    out << "Results (row plays X, column plays O; X wins / draws / O wins)\n";
+    out << QString("X \\ O").leftJustified(width);
+    for (const QString& engine : report.engines) {
+        out << engine.rightJustified(cellWidth);
+    }
+    out << "\n";
+    for (int x = 0; x < engineCount; ++x) {
+        out << report.engines[x].leftJustified(width);
+        for (int o = 0; o < engineCount; ++o) {
+            const PairingResult& result = report.results[x * engineCount + o];
+            out << QString("%1/%2/%3").arg(result.xWins).arg(result.draws).arg(result.oWins).rightJustified(cellWidth);
+        }
+        out << "\n";
+    }
+
+    out << "\nScore over both colours (wins + draws/2, out of games played)\n";
+    for (int e = 0; e < engineCount; ++e) {
+        double points = 0;
+        int games = 0;
+        for (int other = 0; other < engineCount; ++other) {
+            const PairingResult& asX = report.results[e * engineCount + other];
+            const PairingResult& asO = report.results[other * engineCount + e];
+            points += asX.xWins + asO.oWins + 0.5 * (asX.draws + asO.draws);
+            games += asX.xWins + asX.draws + asX.oWins + asO.xWins + asO.draws + asO.oWins;
+        }
+        out << report.engines[e].leftJustified(width) << QString::number(points, 'f', 1) << " / " << games << "\n";
+    }
+
+    out << "\nPer move (microseconds)\n";
+    out << QString("engine").leftJustified(width) << QString("moves").rightJustified(10)
+        << QString("nodes/s").rightJustified(14) << QString("p50").rightJustified(10) << QString("p90").rightJustified(10)
+        << QString("p99").rightJustified(10) << QString("max").rightJustified(10) << "\n";
+    quint64 totalNodes = 0;
+    qint64 totalSearch = 0;
+    for (int e = 0; e < engineCount; ++e) {
+        const EngineTiming& timing = report.timing[e];
+        totalNodes += timing.nodes;
+        totalSearch += timing.searchNanoseconds;
+        const double nodesPerSecond = timing.searchNanoseconds > 0 ? timing.nodes * 1e9 / timing.searchNanoseconds : 0;
+        out << report.engines[e].leftJustified(width) << QString::number(timing.moves).rightJustified(10)
+            << QString::number(nodesPerSecond, 'f', 0).rightJustified(14)
+            << microseconds(timing.p50Nanoseconds).rightJustified(10) << microseconds(timing.p90Nanoseconds).rightJustified(10)
+            << microseconds(timing.p99Nanoseconds).rightJustified(10) << microseconds(timing.maxNanoseconds).rightJustified(10)
+            << "\n";
+    }
+
+    out << "\nGames: " << report.games << " in " << QString::number(report.wallSeconds, 'f', 2) << " s ("
+        << QString::number(report.wallSeconds > 0 ? report.games / report.wallSeconds : 0, 'f', 0) << " games/s, "
+        << QString::number(totalSearch > 0 ? totalNodes * 1e9 / totalSearch : 0, 'f', 0) << " nodes/s per thread)\n";
+    out << "Seed: " << config.seed << "\n";
+    if (report.invalidMoves > 0) {
+        out << "WARNING: " << report.invalidMoves << " illegal moves were played (counted as losses)\n";
+    }
+    if (report.verdictMismatches > 0) {
+        out << "WARNING: GameCore and WinKernel disagreed on " << report.verdictMismatches << " positions\n";
+    }
+}
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("selfplay");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Plays the AI difficulties against each other and reports strength and speed.");
+    parser.addHelpOption();
+    const QCommandLineOption enginesOption("engines", "Comma-separated difficulties (default easy,medium,hard,mcts).", "list");
+    const QCommandLineOption gamesOption("games", "Games per (X, O) pairing (default 100).", "n", "100");
+    const QCommandLineOption boardOption("board", "3x3, 4x4, 5x5 or 15x15 (default 3x3).", "size", "3x3");
+    const QCommandLineOption nodesOption("nodes", "Node (or MCTS playout) budget per move (default 20000).", "n", "20000");
+    const QCommandLineOption timeOption("time-ms", "Time budget per move; 0 = none (default). Makes results timing dependent.", "ms", "0");
+    const QCommandLineOption depthOption("depth", "Depth limit per move; 0 = none (default).", "plies", "0");
+    const QCommandLineOption threadsOption("threads", "Worker threads; 0 = one per core (default).", "n", "0");
+    const QCommandLineOption seedOption("seed", "Tournament seed (default 1).", "n", "1");
+    parser.addOptions({enginesOption, gamesOption, boardOption, nodesOption, timeOption, depthOption, threadsOption, seedOption});
+    parser.process(app);
+
+    SelfPlayConfig config;
+    if (parser.isSet(enginesOption)) {
+        config.engines = parser.value(enginesOption).split(',', Qt::SkipEmptyParts);
+    }
+    config.gamesPerPairing = parser.value(gamesOption).toInt();
+    config.limits.nodeBudget = parser.value(nodesOption).toULongLong();
+    config.limits.timeBudgetMs = parser.value(timeOption).toLongLong();
+    config.limits.maxDepth = parser.value(depthOption).toInt();
+    config.threads = parser.value(threadsOption).toInt();
+    config.seed = parser.value(seedOption).toULongLong();
+
+    QTextStream err(stderr);
+    if (!parseVariant(parser.value(boardOption), config.variant)) {
+        err << "Unknown board size: " << parser.value(boardOption) << "\n";
+        return 1;
+    }
+    if (config.engines.isEmpty() || config.gamesPerPairing <= 0) {
+        err << "Need at least one engine and one game per pairing\n";
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    printReport(SelfPlay::run(config), config, out);
+    return 0;
+}
@@ -0,0 +1,35 @@
+QT += core
+QT -= gui
+CONFIG += console c++17
+CONFIG -= app_bundle
+TEMPLATE = app
+TARGET = selfplay
+
+# SolvedTable.cpp solves every 3x3 position at compile time, which needs more than clang's and MSVC's default constexpr budget
+contains(QMAKE_COMPILER, clang) {
+    QMAKE_CXXFLAGS += -fconstexpr-steps=100000000
+} else:msvc {
+    QMAKE_CXXFLAGS += /constexpr:steps100000000
+}
+
+# The engines are compiled from the app's sources, like the tests do
+APP_DIR = ../app
+INCLUDEPATH += $$APP_DIR
+
+SOURCES += \
+    main.cpp \
+    SelfPlay.cpp
+
+SOURCES += \
+    $$APP_DIR/board.cpp \
+    $$APP_DIR/AnyBoard.cpp \
+    $$APP_DIR/GameCore.cpp \
+    $$APP_DIR/AIPlayer.cpp \
+    $$APP_DIR/TranspositionTable.cpp \
+    $$APP_DIR/ConcurrentTranspositionTable.cpp \
+    $$APP_DIR/SolvedTable.cpp \
+    $$APP_DIR/WinKernel.cpp
+
+HEADERS += \
+    SelfPlay.h \
+    $$APP_DIR/AIPlayer.h
@@ -1,32 +1,44 @@
-QT += testlib widgets sql
-CONFIG += console testcase
-CONFIG -= app_bundle
-TEMPLATE = app
+#include <QApplication>
+#include <QtTest>
+#include "tst_aiplayer.h"
+#include "tst_databasemanager.h"
+#include "tst_gamecore.h"
+#include "tst_gamehistorymodel.h"
+#include "tst_gamehistorywriter.h"
+#include "tst_gamelogic.h"
+#include "tst_gridboard.h"
+#include "tst_testboard.h"
+#include "tst_winkernel.h"
 
-APP_DIR = ../app
+// Runs every test class in turn; the exit code is non-zero if any of them failed.
+// Arguments are passed on to each QTest::qExec (e.g. -v2, or a test function name).
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv); // Needed for the event loop (AIPlayer delivers moves through it)
 
-INCLUDEPATH += $$APP_DIR \
-               $$APP_DIR/core \
-               $$APP_DIR/logic \
-               $$APP_DIR/database \
-               $$APP_DIR/utils
+    int status = 0;
+    auto run = [&status, argc, argv](QObject* testClass) {
+        status |= QTest::qExec(testClass, argc, argv);
+    };
 
-SOURCES += \
-    test_main.cpp \
-    tst_aiplayer.cpp \
-    tst_databasemanager.cpp \
-    tst_testboard.cpp \
-    tst_gamelogic.cpp
+    TestBoard board;
+    run(&board);
+    TestGridBoard gridBoard;
+    run(&gridBoard);
+    TestWinKernel winKernel;
+    run(&winKernel);
+    TestGameCore gameCore;
+    run(&gameCore);
+    TestGameLogic gameLogic;
+    run(&gameLogic);
+    TestAIPlayer aiPlayer;
+    run(&aiPlayer);
+    TestDatabaseManager databaseManager;
+    run(&databaseManager);
+    TestGameHistoryWriter historyWriter;
+    run(&historyWriter);
+    TestGameHistoryModel historyModel;
+    run(&historyModel);
 
-SOURCES += \
-    $$APP_DIR/board.cpp \
-    $$APP_DIR/gamelogic.cpp \
-    $$APP_DIR/AIPlayer.cpp \
-    $$APP_DIR/DatabaseManager.cpp \
-    $$APP_DIR/messagebox.cpp
-
-HEADERS += \
-    tst_aiplayer.h \
-    tst_databasemanager.h \
-    tst_testboard.h \
-    tst_gamelogic.h
+    return status;
+}
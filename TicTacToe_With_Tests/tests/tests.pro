@@ -3,6 +3,13 @@ CONFIG += console testcase
 CONFIG -= app_bundle
 TEMPLATE = app
 
+# SolvedTable.cpp solves every 3x3 position at compile time, which needs more than clang's and MSVC's default constexpr budget
+contains(QMAKE_COMPILER, clang) {
+    QMAKE_CXXFLAGS += -fconstexpr-steps=100000000
+} else:msvc {
+    QMAKE_CXXFLAGS += /constexpr:steps100000000
+}
+
 # Define the relative path to the app directory.
 # From the 'tests' folder, this is one level up and into the 'app' folder.
 APP_DIR = ../app
@@ -21,15 +28,29 @@ SOURCES += \
     tst_aiplayer.cpp \
     tst_databasemanager.cpp \
     tst_testboard.cpp \
-    tst_gamelogic.cpp
+    tst_gamelogic.cpp \
+    tst_gridboard.cpp \
+    tst_gamecore.cpp \
+    tst_winkernel.cpp \
+    tst_gamehistorywriter.cpp \
+    tst_gamehistorymodel.cpp
 
 # Also, list THE APPLICATION'S source files.
 # They need to be compiled and linked with the tests to create the final test executable.
 SOURCES += \
     $$APP_DIR/board.cpp \
+    $$APP_DIR/AnyBoard.cpp \
+    $$APP_DIR/GameCore.cpp \
     $$APP_DIR/gamelogic.cpp \
     $$APP_DIR/AIPlayer.cpp \
+    $$APP_DIR/TranspositionTable.cpp \
+    $$APP_DIR/ConcurrentTranspositionTable.cpp \
+    $$APP_DIR/SolvedTable.cpp \
+    $$APP_DIR/WinKernel.cpp \
     $$APP_DIR/DatabaseManager.cpp \
+    $$APP_DIR/DatabaseConnectionPool.cpp \
+    $$APP_DIR/GameHistoryWriter.cpp \
+    $$APP_DIR/GameHistoryModel.cpp \
     $$APP_DIR/messagebox.cpp
 
 # List the test header files that use Q_OBJECT and need the moc.
@@ -37,4 +58,11 @@ HEADERS += \
     tst_aiplayer.h \
     tst_databasemanager.h \
     tst_testboard.h \
-    tst_gamelogic.h
+    tst_gamelogic.h \
+    tst_gridboard.h \
+    tst_gamecore.h \
+    tst_winkernel.h \
+    tst_gamehistorywriter.h \
+    tst_gamehistorymodel.h \
+    $$APP_DIR/GameHistoryWriter.h \
+    $$APP_DIR/GameHistoryModel.h
@@ -1,5 +1,30 @@
 #include "tst_aiplayer.h"
 #include "board.h" // You must include the header for the Board class
+#include "SolvedTable.h"
+#include "GridSearch.h"
+#include "ConcurrentTranspositionTable.h"
+#include "MctsEngine.h"
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations made on the current thread, so a test can prove the search core never allocates.
+static thread_local quint64 allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
 
 void TestAIPlayer::testAiShouldWinWhenPossible() {
     AIPlayer ai;
@@ -27,4 +52,497 @@ void TestAIPlayer::testAiShouldBlockPlayerWin() {
     QCOMPARE(bestMove, QPoint(2, 2));
 }
 
-#include "tst_aiplayer.moc"
+void TestAIPlayer::testSearchDoesNotAllocate() {
+    AIPlayer ai;
+    Board board;
+    board.makeMove(1, 1, Board::PLAYER_X);
+
+    const quint64 allocationsBefore = allocationCount;
+    QPoint bestMove = ai.searchBestMove(board); // Bypass the solved table so the search really runs
+    const quint64 allocations = allocationCount - allocationsBefore;
+
+    QVERIFY(bestMove != QPoint(-1, -1));
+    QVERIFY(ai.lastSearchNodeCount() > 0);
+    QCOMPARE(allocations, quint64(0)); // Zero allocations in total means zero per node
+}
+
+void TestAIPlayer::testTranspositionTableReuse() {
+    AIPlayer ai;
+    Board board;
+
+    QPoint firstMove = ai.searchBestMove(board);
+    const quint64 coldNodes = ai.lastSearchNodeCount();
+
+    // The table survives between calls, so the same search is answered almost entirely from it
+    QPoint secondMove = ai.searchBestMove(board);
+    const quint64 warmNodes = ai.lastSearchNodeCount();
+
+    QCOMPARE(secondMove, firstMove);
+    QVERIFY(warmNodes * 10 < coldNodes);
+    QVERIFY(ai.transpositionStats().hits > 0);
+    QCOMPARE(ai.transpositionStats().probes,
+             ai.transpositionStats().hits + ai.transpositionStats().misses + ai.transpositionStats().collisions);
+}
+
+// Walks every position reachable from the empty board (X first) and calls visit() on the ones where O is to move
+template <typename Visitor>
+static void forEachAiTurn(Board& board, int player, Visitor visit) {
+    if (board.checkWin() != Board::EMPTY || board.isFull()) {
+        return;
+    }
+    if (player == Board::PLAYER_O) {
+        visit(board);
+    }
+    for (int cell = 0; cell < 9; ++cell) {
+        if (board.makeMove(cell / 3, cell % 3, player)) {
+            forEachAiTurn(board, -player, visit);
+            board.undoMove(cell / 3, cell % 3);
+        }
+    }
+}
+
+void TestAIPlayer::testSolvedTableMatchesMinimax() {
+    AIPlayer ai;
+    Board board;
+    int positions = 0;
+
+    forEachAiTurn(board, Board::PLAYER_X, [&](const Board& position) {
+        QPoint tableMove = ai.findBestMove(position);
+        QCOMPARE(ai.lastSearchNodeCount(), quint64(0)); // Answered by the table, no search
+        QCOMPARE(tableMove, ai.searchBestMove(position));
+        ++positions;
+    });
+    QVERIFY(positions > 0);
+
+    // Positions outside a normal game (O moved first) still fall back to the search
+    Board oFirst;
+    oFirst.makeMove(0, 0, Board::PLAYER_O);
+    oFirst.makeMove(2, 2, Board::PLAYER_X);
+    QCOMPARE(SolvedTable::bestMove(oFirst, Board::PLAYER_O), -1);
+    QVERIFY(ai.findBestMove(oFirst) != QPoint(-1, -1));
+    QVERIFY(ai.lastSearchNodeCount() > 0);
+}
+
+void TestAIPlayer::testMoveIsDeliveredFromWorker() {
+    AIPlayer ai;
+    QSignalSpy spy(&ai, &AIPlayer::moveDetermined);
+
+    AnyBoard board;
+    board.makeMove(0, 0, Board::PLAYER_X);
+    ai.makeMove(board, "hard");
+    QCOMPARE(spy.count(), 0); // Nothing is searched or emitted synchronously
+
+    QVERIFY(spy.wait(5000));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.takeFirst().at(0).toPoint(), QPoint(1, 1)); // Only the centre holds the draw against a corner
+}
+
+void TestAIPlayer::testCancelledMoveIsNeverDelivered() {
+    AIPlayer ai;
+    QSignalSpy spy(&ai, &AIPlayer::moveDetermined);
+
+    ai.makeMove(AnyBoard(BoardVariant::Grid5x5), "hard");
+    ai.cancelPendingMove();
+    QTest::qWait(1000); // Longer than the presentation delay
+    QCOMPARE(spy.count(), 0);
+
+    // A superseded request is dropped too; only the latest one answers
+    AnyBoard first;
+    first.makeMove(1, 1, Board::PLAYER_X);
+    ai.makeMove(first, "hard");
+    AnyBoard second;
+    second.makeMove(0, 0, Board::PLAYER_X);
+    ai.makeMove(second, "hard");
+    QVERIFY(spy.wait(5000));
+    QTest::qWait(200);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.takeFirst().at(0).toPoint(), QPoint(1, 1));
+}
+
+void TestAIPlayer::testIterativeDeepeningRespectsBudget() {
+    GridBoard<15, 5> board;
+    board.makeMove(7, 7, Board::PLAYER_X);
+    board.makeMove(7, 8, Board::PLAYER_O);
+    board.makeMove(8, 8, Board::PLAYER_X);
+
+    // A depth cap is reached exactly
+    SearchLimits depthLimited;
+    depthLimited.maxDepth = 2;
+    GridSearch<GridBoard<15, 5>> shallow{SearchControl(depthLimited)};
+    QPoint move = shallow.findBestMove(board, Board::PLAYER_O);
+    QCOMPARE(shallow.lastCompletedDepth(), 2);
+    QCOMPARE(board.getCell(move.x(), move.y()), Board::EMPTY);
+
+    // A node budget stops mid-iteration, and the answer comes from the last finished one
+    SearchLimits nodeLimited;
+    nodeLimited.nodeBudget = 5000;
+    GridSearch<GridBoard<15, 5>> budgeted{SearchControl(nodeLimited)};
+    move = budgeted.findBestMove(board, Board::PLAYER_O);
+    QVERIFY(budgeted.lastSearchNodeCount() <= 5000);
+    QVERIFY(budgeted.lastCompletedDepth() >= 1);
+    QCOMPARE(board.getCell(move.x(), move.y()), Board::EMPTY);
+
+    // With no depth cap, the time budget bounds the latency
+    SearchLimits timeLimited;
+    timeLimited.timeBudgetMs = 50;
+    GridSearch<GridBoard<15, 5>> timed{SearchControl(timeLimited)};
+    QElapsedTimer timer;
+    timer.start();
+    move = timed.findBestMove(board, Board::PLAYER_O);
+    QVERIFY(timer.elapsed() < 1000);
+    QCOMPARE(board.getCell(move.x(), move.y()), Board::EMPTY);
+
+    // Searches under a shared deadline split one budget instead of each getting a full one (a ponder pass)
+    SearchControl shared(timeLimited);
+    shared.beginSharedDeadline();
+    timer.restart();
+    for (int k = 0; k < 4; ++k) {
+        GridSearch<GridBoard<15, 5>> reply{shared};
+        move = reply.findBestMove(board, Board::PLAYER_O);
+        QCOMPARE(board.getCell(move.x(), move.y()), Board::EMPTY);
+    }
+    shared.endSharedDeadline();
+    QVERIFY(timer.elapsed() < 4 * timeLimited.timeBudgetMs);
+
+    // On 3x3 a shallow iteration still sees the fork after X takes opposite corners
+    AIPlayer ai;
+    ai.searchControl.setLimits(depthLimited);
+    Board classic;
+    classic.makeMove(0, 0, Board::PLAYER_X);
+    classic.makeMove(1, 1, Board::PLAYER_O);
+    classic.makeMove(2, 2, Board::PLAYER_X);
+    move = ai.searchBestMove(classic);
+    QVERIFY(move.x() == 1 || move.y() == 1); // An edge, not a corner
+}
+
+void TestAIPlayer::testPresentationDelayCanBeDisabled() {
+    AIPlayer ai;
+    ai.setPresentationDelay(0);
+    QSignalSpy spy(&ai, &AIPlayer::moveDetermined);
+
+    AnyBoard board;
+    board.makeMove(0, 0, Board::PLAYER_X);
+    QElapsedTimer timer;
+    timer.start();
+    ai.makeMove(board, "hard");
+    QVERIFY(spy.wait(5000));
+    QVERIFY(timer.elapsed() < 400); // Well under the default delay
+    QCOMPARE(spy.takeFirst().at(0).toPoint(), QPoint(1, 1));
+}
+
+void TestAIPlayer::testConcurrentTableRejectsTornEntries() {
+    ConcurrentTranspositionTable table(8); // Small, so the writers keep hitting the same slots
+    ConcurrentTranspositionTable::Entry entry;
+    table.store(0x1234, -999999, 7, 224, TranspositionTable::LOWER_BOUND);
+    QVERIFY(table.probe(0x1234, entry));
+    QCOMPARE(int(entry.score), -999999);
+    QCOMPARE(int(entry.depth), 7);
+    QCOMPARE(int(entry.bestMove), 224);
+    QCOMPARE(entry.bound, TranspositionTable::LOWER_BOUND);
+    QVERIFY(!table.probe(0x1234 + 256, entry)); // Same slot, different position
+
+    // 1024 keys fight over 256 slots. Each entry is derived from its key, so a hit with any other data would be a torn read
+    std::atomic<int> badReads{0};
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    for (int thread = 0; thread < 4; ++thread) {
+        pool.start([&table, &badReads, thread]() {
+            for (quint64 i = 0; i < 200000; ++i) {
+                const Board::Hash key = ((i * 7 + thread) % 1024 + 1) * 0x9E3779B97F4A7C15ULL;
+                table.store(key, int(key % 100000), 1, int(key % 200), TranspositionTable::EXACT);
+                ConcurrentTranspositionTable::Entry seen;
+                const Board::Hash probed = ((i * 13 + thread) % 1024 + 1) * 0x9E3779B97F4A7C15ULL;
+                if (table.probe(probed, seen) && (seen.score != int(probed % 100000) || seen.bestMove != int(probed % 200))) {
+                    ++badReads;
+                }
+            }
+        });
+    }
+    pool.waitForDone();
+    QCOMPARE(badReads.load(), 0);
+}
+
+void TestAIPlayer::testParallelSearchMatchesSingleThread() {
+    GridBoard<5, 4> board;
+    board.makeMove(2, 2, Board::PLAYER_X);
+    board.makeMove(1, 2, Board::PLAYER_O);
+    board.makeMove(2, 1, Board::PLAYER_X);
+
+    SearchLimits limits;
+    limits.maxDepth = 4;
+    GridSearch<GridBoard<5, 4>> first{SearchControl(limits)};
+    GridSearch<GridBoard<5, 4>> second{SearchControl(limits)};
+    const QPoint sequential = first.findBestMove(board, Board::PLAYER_O);
+    QCOMPARE(second.findBestMove(board, Board::PLAYER_O), sequential); // Single-threaded is reproducible
+    QCOMPARE(second.lastSearchNodeCount(), first.lastSearchNodeCount());
+
+    // Same answer when the root moves are split over several threads sharing one table, however the
+    // threads happen to interleave (tied root moves must still go to the earlier one)
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+    for (int run = 0; run < 10; ++run) {
+        ConcurrentTranspositionTable table;
+        GridSearch<GridBoard<5, 4>> parallel{SearchControl(limits)};
+        parallel.setTranspositionTable(&table);
+        parallel.setParallelism(&pool, 3);
+        QCOMPARE(parallel.findBestMove(board, Board::PLAYER_O), sequential);
+        QCOMPARE(parallel.lastCompletedDepth(), 4);
+    }
+}
+
+void TestAIPlayer::testMctsFindsWinsAndBlocks() {
+    SearchLimits limits;
+    limits.nodeBudget = 3000;
+
+    MctsEngine<Board> engine(1);
+    Board board;
+    board.makeMove(0, 0, Board::PLAYER_O);
+    board.makeMove(1, 0, Board::PLAYER_X);
+    board.makeMove(0, 1, Board::PLAYER_O);
+    board.makeMove(1, 1, Board::PLAYER_X);
+    QCOMPARE(engine.findBestMove(board, Board::PLAYER_O, SearchControl(limits)), QPoint(0, 2));
+    QCOMPARE(engine.lastStats().iterations, quint64(3000)); // The playout budget is exact
+
+    Board threat;
+    threat.makeMove(0, 0, Board::PLAYER_X);
+    threat.makeMove(1, 1, Board::PLAYER_O);
+    threat.makeMove(0, 1, Board::PLAYER_X);
+    QCOMPARE(engine.findBestMove(threat, Board::PLAYER_O, SearchControl(limits)), QPoint(0, 2));
+
+    // Selectable as a difficulty; the answer still arrives through moveDetermined
+    AIPlayer ai;
+    ai.setPresentationDelay(0);
+    ai.setSearchLimits(limits);
+    QSignalSpy spy(&ai, &AIPlayer::moveDetermined);
+    AnyBoard large(BoardVariant::Gomoku15x15);
+    large.makeMove(7, 7, Board::PLAYER_X);
+    ai.makeMove(large, "mcts");
+    QVERIFY(spy.wait(5000));
+    const QPoint move = spy.takeFirst().at(0).toPoint();
+    QCOMPARE(large.getCell(move.x(), move.y()), Board::EMPTY);
+    QCOMPARE(ai.lastMctsStats().iterations, quint64(3000));
+}
+
+void TestAIPlayer::testMctsReusesSubtreeAfterReply() {
+    SearchLimits limits;
+    limits.nodeBudget = 2000;
+    MctsEngine<GridBoard<5, 4>> engine(7);
+
+    GridBoard<5, 4> board;
+    board.makeMove(2, 2, Board::PLAYER_X);
+    const QPoint first = engine.findBestMove(board, Board::PLAYER_O, SearchControl(limits));
+    QCOMPARE(engine.lastStats().reusedVisits, quint64(0));
+    QVERIFY(board.makeMove(first.x(), first.y(), Board::PLAYER_O));
+
+    // The engine's own move and the opponent's reply were both explored, so each step keeps a subtree
+    const QPoint reply = engine.findBestMove(board, Board::PLAYER_X, SearchControl(limits));
+    QVERIFY(engine.lastStats().reusedVisits > 0);
+    QVERIFY(board.makeMove(reply.x(), reply.y(), Board::PLAYER_X));
+    engine.findBestMove(board, Board::PLAYER_O, SearchControl(limits));
+    QVERIFY(engine.lastStats().reusedVisits > 0);
+    QVERIFY(engine.lastStats().treeNodes > 0);
+}
+
+void TestAIPlayer::testPonderedReplyIsAnsweredFromCache() {
+    AIPlayer ai;
+    ai.setPresentationDelay(0);
+    SearchLimits limits;
+    limits.nodeBudget = 20000;
+    ai.setSearchLimits(limits);
+    QSignalSpy spy(&ai, &AIPlayer::moveDetermined);
+
+    AnyBoard board(BoardVariant::Grid5x5);
+    board.makeMove(2, 2, Board::PLAYER_X);
+    board.makeMove(1, 1, Board::PLAYER_O);
+    ai.ponder(board, "hard");
+    ai.searchPool.waitForDone();
+    QCOMPARE(spy.count(), 0); // Pondering never emits a move
+    QCOMPARE(ai.ponderCache.size(), std::size_t(4));
+
+    // The human plays the reply ranked most likely, which was searched ahead of time
+    int reply = -1;
+    board.visit([&reply](const auto& grid) {
+        GridSearch<std::decay_t<decltype(grid)>>().rankMoves(grid, Board::PLAYER_X, &reply, 1);
+    });
+    board.makeMove(reply / 5, reply % 5, Board::PLAYER_X);
+    QPoint pondered(-1, -1);
+    for (const auto& entry : ai.ponderCache) {
+        if (entry.hash == board.getHash()) {
+            pondered = entry.move;
+        }
+    }
+    QVERIFY(pondered != QPoint(-1, -1));
+    ai.makeMove(board, "hard");
+    QVERIFY(spy.wait(5000));
+    QCOMPARE(ai.ponderHitCount(), quint64(1));
+    QCOMPARE(spy.takeFirst().at(0).toPoint(), pondered);
+    QVERIFY(ai.ponderCache.empty()); // Spent by the request
+
+    // An unexpected reply is searched normally
+    board.makeMove(0, 0, Board::PLAYER_O);
+    board.makeMove(4, 4, Board::PLAYER_X);
+    ai.makeMove(board, "hard");
+    QVERIFY(spy.wait(5000));
+    QCOMPARE(ai.ponderHitCount(), quint64(1));
+
+    // Under the default time budget, and after a real search has run on the worker, the pass still splits its
+    // time over all four replies
+    AIPlayer timed;
+    timed.setPresentationDelay(0);
+    QSignalSpy timedSpy(&timed, &AIPlayer::moveDetermined);
+    AnyBoard grid(BoardVariant::Grid5x5);
+    grid.makeMove(2, 2, Board::PLAYER_X);
+    timed.makeMove(grid, "hard");
+    QVERIFY(timedSpy.wait(5000));
+    const QPoint aiMove = timedSpy.takeFirst().at(0).toPoint();
+    grid.makeMove(aiMove.x(), aiMove.y(), Board::PLAYER_O);
+    timed.ponder(grid, "hard");
+    timed.searchPool.waitForDone();
+    QCOMPARE(timed.ponderCache.size(), std::size_t(4));
+}
+
+void TestAIPlayer::testBatchEvaluation() {
+    // Every packed value, valid or not, in one contiguous batch: large enough to take the parallel path
+    std::vector<Board::PackedPosition> positions(1 << 18);
+    for (Board::PackedPosition p = 0; p < positions.size(); ++p) {
+        positions[p] = p;
+    }
+    std::vector<SolvedTable::Evaluation> serial(positions.size());
+    std::vector<SolvedTable::Evaluation> parallel(positions.size());
+    AIPlayer::evaluatePositions(positions.data(), positions.size(), serial.data(), 1);
+    AIPlayer::evaluatePositions(positions.data(), positions.size(), parallel.data(), 4);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        QCOMPARE(parallel[i].bestMove, serial[i].bestMove);
+        QCOMPARE(parallel[i].score, serial[i].score);
+    }
+
+    // Matches the single-position lookup on every AI turn
+    Board board;
+    int mismatches = 0;
+    forEachAiTurn(board, Board::PLAYER_X, [&](const Board& position) {
+        if (serial[position.pack()].bestMove != SolvedTable::bestMove(position, Board::PLAYER_O)) {
+            ++mismatches;
+        }
+    });
+    QCOMPARE(mismatches, 0);
+
+    board.makeMove(1, 1, Board::PLAYER_O); // O opened; X to move is answered like the mirrored X-first game
+    QCOMPARE(int(serial[board.pack()].bestMove), 0);
+    QCOMPARE(int(serial[board.pack()].score), 0);
+
+    Board won;
+    won.makeMove(0, 0, Board::PLAYER_X);
+    won.makeMove(1, 0, Board::PLAYER_O);
+    won.makeMove(0, 1, Board::PLAYER_X);
+    won.makeMove(1, 1, Board::PLAYER_O);
+    won.makeMove(0, 2, Board::PLAYER_X);
+    QCOMPARE(int(serial[won.pack()].bestMove), -1); // Game over: O to move has lost
+    QCOMPARE(int(serial[won.pack()].score), -1);
+    QCOMPARE(int(serial[0x1 | (0x1 << 9)].bestMove), -1); // Both marks in one cell
+    QCOMPARE(int(serial[0x7].bestMove), -1); // Three X marks, no O
+}
+
+void TestAIPlayer::testComputeMoveForEitherSide() {
+    AIPlayer ai;
+    AnyBoard board;
+    board.makeMove(0, 0, Board::PLAYER_X);
+    board.makeMove(1, 0, Board::PLAYER_O);
+    board.makeMove(0, 1, Board::PLAYER_X);
+    board.makeMove(1, 1, Board::PLAYER_O);
+    QCOMPARE(ai.computeMove(board, "hard", Board::PLAYER_X), QPoint(0, 2)); // X completes the top row
+    QCOMPARE(ai.computeMove(board, "hard", Board::PLAYER_O), QPoint(0, 2)); // O must block it
+
+    // O opened: the colour-swapped table answers at once instead of a search
+    AnyBoard oOpened;
+    oOpened.makeMove(1, 1, Board::PLAYER_O);
+    oOpened.makeMove(0, 0, Board::PLAYER_X);
+    const QPoint reply = ai.computeMove(oOpened, "hard", Board::PLAYER_O);
+    QCOMPARE(ai.lastSearchNodeCount(), quint64(0));
+    QVERIFY(oOpened.getCell(reply.x(), reply.y()) == Board::EMPTY);
+
+    // The same seed replays the same random choices
+    AIPlayer first;
+    AIPlayer second;
+    first.setRandomSeed(42);
+    second.setRandomSeed(42);
+    AnyBoard empty(BoardVariant::Grid5x5);
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(first.computeMove(empty, "easy"), second.computeMove(empty, "easy"));
+    }
+
+    // Reseeded and cleared, a player that has already searched plays like a new one (the self-play workers rely on it)
+    SearchLimits playouts;
+    playouts.nodeBudget = 2000;
+    AIPlayer reused;
+    reused.setSearchLimits(playouts);
+    AnyBoard grid(BoardVariant::Grid4x4);
+    grid.makeMove(1, 1, Board::PLAYER_X);
+    reused.computeMove(grid, "mcts");
+    reused.computeMove(grid, "hard");
+    reused.setRandomSeed(7);
+    reused.clearTables();
+    AIPlayer fresh;
+    fresh.setSearchLimits(playouts);
+    fresh.setRandomSeed(7);
+    for (const QString difficulty : {"mcts", "hard", "medium"}) {
+        QCOMPARE(reused.computeMove(grid, difficulty), fresh.computeMove(grid, difficulty));
+        QCOMPARE(reused.lastSearchNodeCount(), fresh.lastSearchNodeCount());
+    }
+}
+
+void TestAIPlayer::testSearchStatsAreReported() {
+    AIPlayer ai;
+    SearchLimits limits;
+    limits.nodeBudget = 20000;
+    ai.setSearchLimits(limits);
+
+    AnyBoard grid(BoardVariant::Grid4x4);
+    grid.makeMove(1, 1, Board::PLAYER_X);
+    ai.computeMove(grid, "hard");
+    const SearchStats& stats = ai.lastSearchStats();
+    QCOMPARE(stats.nodes, ai.lastSearchNodeCount());
+    QVERIFY(stats.completedDepth >= 1);
+    QVERIFY(stats.elapsedNanoseconds > 0);
+    QVERIFY(!stats.precomputed);
+#if AI_SEARCH_STATS
+    QVERIFY(stats.leafEvaluations > 0 && stats.leafEvaluations <= stats.nodes);
+    QVERIFY(stats.cutoffs > 0);
+    quint64 cutoffsByPly = 0;
+    for (quint64 count : stats.cutoffsByPly) {
+        cutoffsByPly += count;
+    }
+    QCOMPARE(cutoffsByPly, stats.cutoffs);
+    QCOMPARE(stats.cutoffsByPly[0], quint64(0)); // The root's own move loop is not a cutoff
+    QVERIFY(stats.tableProbes > 0 && stats.tableHits <= stats.tableProbes);
+    QVERIFY(stats.maxPly >= stats.completedDepth);
+#endif
+
+    // Medium's one-ply look on a grid counts the moves it tried, instead of keeping the last search's count
+    ai.computeMove(grid, "medium");
+    QVERIFY(ai.lastSearchNodeCount() > 0);
+    QVERIFY(ai.lastSearchNodeCount() <= quint64(2 * grid.size() * grid.size()));
+    QCOMPARE(ai.lastSearchStats().nodes, ai.lastSearchNodeCount());
+
+    // The 3x3 table answers without searching, and the stats arrive with the move
+    ai.setPresentationDelay(0);
+    QSignalSpy statsSpy(&ai, &AIPlayer::searchStatsReady);
+    QSignalSpy moveSpy(&ai, &AIPlayer::moveDetermined);
+    AnyBoard classic;
+    classic.makeMove(0, 0, Board::PLAYER_X);
+    ai.makeMove(classic, "hard");
+    QVERIFY(moveSpy.wait(5000));
+    QCOMPARE(statsSpy.count(), 1);
+    QVERIFY(ai.lastSearchStats().precomputed);
+    QCOMPARE(ai.lastSearchStats().nodes, quint64(0));
+}
+
+void TestAIPlayer::testPerftCountsKnownTotals() {
+    const SearchStats classic = AIPlayer::perft(AnyBoard(), Board::PLAYER_X);
+    QCOMPARE(classic.nodes, quint64(549946));           // Every position of every game, the empty board included
+    QCOMPARE(classic.leafEvaluations, quint64(255168)); // Distinct complete games
+    QCOMPARE(classic.maxPly, 9);
+
+    const SearchStats grid = AIPlayer::perft(AnyBoard(BoardVariant::Grid4x4), Board::PLAYER_X, 3);
+    QCOMPARE(grid.nodes, quint64(1 + 16 + 16 * 15 + 16 * 15 * 14));
+    QCOMPARE(grid.leafEvaluations, quint64(16 * 15 * 14)); // Nobody can win within three plies
+}
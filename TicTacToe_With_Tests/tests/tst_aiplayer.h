@@ -10,6 +10,22 @@ class TestAIPlayer : public QObject
 private slots:
     void testAiShouldWinWhenPossible();
     void testAiShouldBlockPlayerWin();
+    void testSearchDoesNotAllocate();
+    void testTranspositionTableReuse();
+    void testSolvedTableMatchesMinimax();
+    void testMoveIsDeliveredFromWorker();
+    void testCancelledMoveIsNeverDelivered();
+    void testIterativeDeepeningRespectsBudget();
+    void testPresentationDelayCanBeDisabled();
+    void testConcurrentTableRejectsTornEntries();
+    void testParallelSearchMatchesSingleThread();
+    void testMctsFindsWinsAndBlocks();
+    void testMctsReusesSubtreeAfterReply();
+    void testPonderedReplyIsAnsweredFromCache();
+    void testBatchEvaluation();
+    void testComputeMoveForEitherSide();
+    void testSearchStatsAreReported();
+    void testPerftCountsKnownTotals();
 };
 
 #endif // TST_AIPLAYER_H
@@ -1,11 +1,22 @@
 #include "tst_databasemanager.h"
 #include "DatabaseManager.h"
+#include "DatabaseConnectionPool.h"
 #include <QFile> // Required for QFile::remove
 #include <QSqlDatabase> // Required for QSqlDatabase
 #include <QSqlQuery> // Required for QSqlQuery
 #include <QSqlError> // Required for QSqlError
 #include <QDebug> // Required for qDebug()
 #include <QTest>  // Explicitly include QTest for QTest::qWait
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+namespace {
+// A game against the AI, saved the way MainWindow saves it
+FinishedGame aiGame(const QString &player, const QString &difficulty, const QString &result)
+{
+    return FinishedGame{player, "AI", result, GameRecord(), difficulty};
+}
+}
 
 void TestDatabaseManager::initTestCase()
 {
@@ -53,7 +64,7 @@ void TestDatabaseManager::testInitializeDatabase()
     QVERIFY(dbManager.initializeDatabase()); //
 
     // Verify tables exist by trying to query them using the same connection used by dbManager
-    QSqlDatabase db = QSqlDatabase::database(); // Gets the default connection, which dbManager uses
+    QSqlDatabase db = dbManager.connection(); // The pooled connection dbManager uses
     QVERIFY(db.isOpen()); //
     QSqlQuery query(db); //
     QVERIFY(query.exec("SELECT name FROM sqlite_master WHERE type='table' AND name='users';")); //
@@ -215,4 +226,370 @@ void TestDatabaseManager::testGetGameMoves()
 
     QString emptyMoves = dbManager.getGameMoves(99999); //
     QVERIFY(emptyMoves.isEmpty()); //
+
+    // The text form carries no board size, so a larger board has to be named
+    QVERIFY(!dbManager.saveGameHistory("player_moves", "AI", "Draw", {"3:3:X"}));
+    QVERIFY(dbManager.saveGameHistory("player_moves", "AI", "Draw", {"3:3:X", "0:0:O"}, BoardVariant::Grid5x5));
+    history = dbManager.loadGameHistory("player_moves");
+    QCOMPARE(history.size(), 2);
+    const GameRecord record = dbManager.getGameRecord(history[0]["id"].toInt());
+    QCOMPARE(record.getVariant(), BoardVariant::Grid5x5);
+    QCOMPARE(record.cell(0), 18);
+}
+
+void TestDatabaseManager::testMovesEncoding()
+{
+    GameRecord moves;
+    QVERIFY(DatabaseManager::parseTextMoves("1:1:X,0:0:O,2:2:X", moves));
+    QCOMPARE(moves.getVariant(), BoardVariant::Classic3x3);
+    QCOMPARE(moves.size(), std::size_t(3));
+
+    const QByteArray bytes = DatabaseManager::encodeMoves(moves);
+    QCOMPARE(bytes.size(), 4); // Variant byte plus one per move
+    GameRecord decoded(BoardVariant::Grid5x5);
+    QVERIFY(DatabaseManager::decodeMoves(bytes, decoded));
+    QVERIFY(decoded == moves);
+    QCOMPARE(DatabaseManager::movesToText(decoded), QString("1:1:X,0:0:O,2:2:X"));
+
+    // Coordinates beyond 2 need a larger board
+    QVERIFY(DatabaseManager::parseTextMoves("3:0:X,0:3:O", moves));
+    QCOMPARE(moves.getVariant(), BoardVariant::Grid4x4);
+    QVERIFY(DatabaseManager::parseTextMoves("14:14:X", moves));
+    QCOMPARE(moves.getVariant(), BoardVariant::Gomoku15x15);
+    QCOMPARE(moves.cell(0), 224);
+
+    // Given the board, coordinates are read on it and nothing is guessed
+    QVERIFY(DatabaseManager::parseTextMoves("1:1:X", BoardVariant::Grid5x5, moves));
+    QCOMPARE(moves.getVariant(), BoardVariant::Grid5x5);
+    QCOMPARE(moves.cell(0), 6);
+    QVERIFY(!DatabaseManager::parseTextMoves("3:0:X", BoardVariant::Classic3x3, moves));
+
+    QVERIFY(!DatabaseManager::parseTextMoves("1:1", moves));
+    QVERIFY(!DatabaseManager::parseTextMoves("15:0:X", moves));
+    QVERIFY(!DatabaseManager::decodeMoves(QByteArray(), moves));
+    QVERIFY(!DatabaseManager::decodeMoves(QByteArray("\x00\x09", 2), moves)); // Cell 9 is off a 3x3 board
+}
+
+void TestDatabaseManager::testMigrateTextMoves()
+{
+    {
+        DatabaseManager dbManager(this, "test_users.db");
+        // A row as saved before moves were stored in binary
+        QSqlQuery insert(dbManager.connection());
+        QVERIFY(insert.exec("INSERT INTO game_history (player1, player2, result, moves) "
+                            "VALUES ('old_player', 'AI', 'Draw', '0:0:X,1:1:O,0:1:X')"));
+    }
+
+    DatabaseManager dbManager(this, "test_users.db"); // Opening the database converts the row
+    QSqlQuery type(dbManager.connection());
+    QVERIFY(type.exec("SELECT typeof(moves) FROM game_history") && type.next());
+    QCOMPARE(type.value(0).toString(), QString("blob"));
+
+    QList<QVariantMap> history = dbManager.loadGameHistory("old_player");
+    QCOMPARE(history.size(), 1);
+    const GameRecord moves = dbManager.getGameRecord(history[0]["id"].toInt());
+    QCOMPARE(moves.size(), std::size_t(3));
+    QCOMPARE(moves.cell(2), 1);
+    QCOMPARE(history[0]["moves"].toString(), QString("0:0:X,1:1:O,0:1:X"));
+}
+
+void TestDatabaseManager::testStatementCache()
+{
+    DatabaseManager dbManager(this, "test_users.db");
+    QCOMPARE(dbManager.statementPrepareCount(), quint64(0));
+    QVERIFY(dbManager.registerUser("cacheUser", "pass", "Cache", "User"));
+
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(dbManager.getUserInfo("cacheUser")["firstName"].toString(), QString("Cache"));
+        QVERIFY(dbManager.authenticateUser("cacheUser", "pass"));
+        QVERIFY(dbManager.saveGameHistory("cacheUser", "AI", "Draw", {"1:1:X"}));
+    }
+    QCOMPARE(dbManager.loadGameHistory("cacheUser").size(), 3);
+    // Each statement once: the five above, plus reading and saving the two ratings of each saved game
+    QCOMPARE(dbManager.statementPrepareCount(), quint64(7));
+    QCOMPARE(dbManager.statementCacheHitCount(), quint64(16)); // Every repeat reused it
+
+    // Initializing again leaves the open connection, and so the prepared statements, alone
+    QVERIFY(dbManager.initializeDatabase());
+    QVERIFY(dbManager.authenticateUser("cacheUser", "pass"));
+    QCOMPARE(dbManager.statementPrepareCount(), quint64(7));
+}
+
+void TestDatabaseManager::testConnectionPerThread()
+{
+    const int before = DatabaseConnectionPool::connectionCount();
+    DatabaseManager first(this, "test_users.db");
+    DatabaseManager second(this, "test_users.db");
+    QCOMPARE(first.connection().connectionName(), second.connection().connectionName()); // Same thread, one connection
+    QCOMPARE(DatabaseConnectionPool::connectionCount(), before + 1);
+
+    QSqlQuery mode(first.connection());
+    QVERIFY(mode.exec("PRAGMA journal_mode") && mode.next());
+    QCOMPARE(mode.value(0).toString(), QString("wal"));
+    mode.finish();
+
+    QString otherThreadConnection;
+    int otherThreadGames = -1;
+    QThreadPool otherThread;
+    otherThread.start([&otherThreadConnection, &otherThreadGames]() {
+        DatabaseManager manager(nullptr, "test_users.db");
+        otherThreadConnection = manager.connection().connectionName();
+        manager.saveGameHistory("pooled", "AI", "Draw", {"1:1:X"});
+        otherThreadGames = manager.loadGameHistory("pooled").size();
+    });
+    otherThread.waitForDone();
+    QVERIFY(otherThreadConnection != first.connection().connectionName());
+    QCOMPARE(otherThreadGames, 1);
+    QCOMPARE(first.loadGameHistory("pooled").size(), 1);
+    QCOMPARE(DatabaseConnectionPool::connectionCount(), before + 1); // The other thread's was closed with its manager
+}
+
+void TestDatabaseManager::testReadersDoNotBlockWriter()
+{
+    DatabaseManager dbManager(this, "test_users.db");
+    QVERIFY(dbManager.saveGameHistory("wal", "AI", "Draw", {"1:1:X"}));
+
+    {
+        // A second connection in the middle of a read transaction
+        QSqlDatabase reader = QSqlDatabase::addDatabase("QSQLITE", "wal_reader");
+        reader.setDatabaseName("test_users.db");
+        QVERIFY(reader.open());
+        QSqlQuery read(reader);
+        QVERIFY(read.exec("BEGIN"));
+        QVERIFY(read.exec("SELECT COUNT(*) FROM game_history") && read.next());
+        QCOMPARE(read.value(0).toInt(), 1);
+        read.finish();
+
+        // With a rollback journal this commit would wait for the reader and time out
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(dbManager.saveGameHistory("wal", "AI", "Draw", {"0:0:X"}));
+        QVERIFY(timer.elapsed() < 1000);
+
+        // The reader keeps its snapshot until its transaction ends
+        QVERIFY(read.exec("SELECT COUNT(*) FROM game_history") && read.next());
+        QCOMPARE(read.value(0).toInt(), 1);
+        read.finish();
+        QVERIFY(read.exec("COMMIT"));
+    }
+    QSqlDatabase::removeDatabase("wal_reader");
+    QCOMPARE(dbManager.loadGameHistory("wal").size(), 2);
+}
+
+void TestDatabaseManager::testHistoryQueryPlan()
+{
+    DatabaseManager dbManager(this, "test_users.db");
+    const QString plan = dbManager.explainHistoryQuery("testuser").join('\n');
+    QVERIFY2(plan.contains("game_history_player1"), qPrintable(plan));
+    QVERIFY2(plan.contains("game_history_player2"), qPrintable(plan));
+    QVERIFY2(!plan.contains("TEMP B-TREE"), qPrintable(plan));
+}
+
+void TestDatabaseManager::testHistoryIncludesBothSides()
+{
+    DatabaseManager dbManager(this, "test_users.db");
+    QVERIFY(dbManager.saveGameHistory("sideA", "sideB", "Draw", {"0:0:X"}));
+    QVERIFY(dbManager.saveGameHistory("sideB", "sideA", "Draw", {"0:0:X"}));
+    QVERIFY(dbManager.saveGameHistory("sideA", "sideA", "Draw", {"0:0:X"}));
+
+    const QList<QVariantMap> history = dbManager.loadGameHistory("sideA");
+    QCOMPARE(history.size(), 3); // The game against itself is listed once
+    QVERIFY(history[0]["id"].toInt() > history[1]["id"].toInt()); // Newest first
+    QVERIFY(history[1]["id"].toInt() > history[2]["id"].toInt());
+    QCOMPARE(dbManager.loadGameHistory("sideB").size(), 2);
+}
+
+void TestDatabaseManager::testOutcomeFromResult()
+{
+    QCOMPARE(DatabaseManager::outcomeFromResult("Player X wins!"), GameOutcome::Player1Won);
+    QCOMPARE(DatabaseManager::outcomeFromResult("AI wins!"), GameOutcome::Player2Won);
+    QCOMPARE(DatabaseManager::outcomeFromResult("Player O wins!"), GameOutcome::Player2Won);
+    QCOMPARE(DatabaseManager::outcomeFromResult("Draw"), GameOutcome::Draw);
+    QCOMPARE(DatabaseManager::outcomeFromResult("Player1 Wins"), GameOutcome::Unknown);
+}
+
+void TestDatabaseManager::testUserStatsFollowHistory()
+{
+    DatabaseManager dbManager(this, "test_users.db");
+    QCOMPARE(dbManager.getUserStats("statsUser").games, 0);
+
+    QVERIFY(dbManager.saveGameHistory("statsUser", "AI", "Player X wins!", {"0:0:X"}));
+    QVERIFY(dbManager.saveGameHistory("statsUser", "AI", "AI wins!", {"0:0:X"}));
+    QVector<FinishedGame> batch;
+    batch.append(FinishedGame{"statsUser", "AI", "Draw", GameRecord()});
+    batch.append(FinishedGame{"statsUser", "AI", "Player X wins!", GameRecord()});
+    QVERIFY(dbManager.saveGameHistoryBatch(batch));
+
+    UserStats stats = dbManager.getUserStats("statsUser");
+    QCOMPARE(stats.games, 4);
+    QCOMPARE(stats.wins, 2);
+    QCOMPARE(stats.losses, 1);
+    QCOMPARE(stats.draws, 1);
+    const UserStats ai = dbManager.getUserStats("AI"); // Counted from its own side
+    QCOMPARE(ai.wins, 1);
+    QCOMPARE(ai.losses, 2);
+
+    const QList<QVariantMap> history = dbManager.loadGameHistory("statsUser");
+    for (const QVariantMap &game : history) {
+        if (game["result"].toString() == "Player X wins!") {
+            QVERIFY(dbManager.deleteGameHistory(game["id"].toInt()));
+            break;
+        }
+    }
+    stats = dbManager.getUserStats("statsUser");
+    QCOMPARE(stats.games, 3);
+    QCOMPARE(stats.wins, 1);
+
+    QVERIFY(dbManager.saveGameHistory("selfPlay", "selfPlay", "Draw", {"0:0:X"}));
+    QCOMPARE(dbManager.getUserStats("selfPlay").games, 1); // Once, not once per side
+}
+
+void TestDatabaseManager::testUserStatsMigration()
+{
+    {
+        // game_history as created before the outcome column and user_stats
+        QSqlDatabase legacy = QSqlDatabase::addDatabase("QSQLITE", "legacy_stats");
+        legacy.setDatabaseName("test_users.db");
+        QVERIFY(legacy.open());
+        QSqlQuery query(legacy);
+        QVERIFY(query.exec("CREATE TABLE game_history (id INTEGER PRIMARY KEY AUTOINCREMENT, player1 TEXT NOT NULL, "
+                           "player2 TEXT NOT NULL, result TEXT NOT NULL, moves BLOB NOT NULL, "
+                           "timestamp DATETIME DEFAULT CURRENT_TIMESTAMP)"));
+        QVERIFY(query.exec("INSERT INTO game_history (player1, player2, result, moves) VALUES "
+                           "('legacy', 'AI', 'Player X wins!', '0:0:X'), ('legacy', 'AI', 'Draw', '0:0:X'), "
+                           "('legacy', 'Player O', 'Player O wins!', '0:0:X')"));
+        query.finish();
+        legacy.close();
+    }
+    QSqlDatabase::removeDatabase("legacy_stats");
+
+    DatabaseManager dbManager(this, "test_users.db"); // Adds the outcomes and counts the existing games
+    const UserStats stats = dbManager.getUserStats("legacy");
+    QCOMPARE(stats.games, 3);
+    QCOMPARE(stats.wins, 1);
+    QCOMPARE(stats.losses, 1);
+    QCOMPARE(stats.draws, 1);
+    QCOMPARE(dbManager.getUserStats("Player O").wins, 1);
+
+    QVERIFY(dbManager.saveGameHistory("legacy", "AI", "Draw", {"0:0:X"})); // And keeps counting from there
+    QCOMPARE(dbManager.getUserStats("legacy").draws, 2);
+
+    // A game that records the AI's difficulty is counted against the same "AI" as the legacy ones
+    const int aiGames = dbManager.getUserStats("AI").games;
+    QVERIFY(dbManager.saveGameHistoryBatch({aiGame("legacy", "hard", "Draw")}));
+    QCOMPARE(dbManager.getUserStats("AI").games, aiGames + 1);
+    QCOMPARE(dbManager.getRating(DatabaseManager::aiPlayerName("hard")).games, 1);
+}
+
+void TestDatabaseManager::testEloRating()
+{
+    QCOMPARE(EloRating::expectedScore(1500.0, 1500.0), 0.5);
+    QVERIFY(EloRating::expectedScore(1900.0, 1500.0) > 0.9); // 400 points: about 10 to 1
+
+    double winner = 1500.0;
+    double loser = 1500.0;
+    EloRating::update(winner, loser, 1.0);
+    QCOMPARE(winner, 1500.0 + EloRating::K_FACTOR / 2);
+    QCOMPARE(loser, 1500.0 - EloRating::K_FACTOR / 2);
+}
+
+void TestDatabaseManager::testRatingsFollowSaves()
+{
+    DatabaseManager dbManager(this, "test_users.db");
+    const QString ai = DatabaseManager::aiPlayerName("hard");
+    QCOMPARE(ai, QString("AI (hard)"));
+    QCOMPARE(dbManager.getRating("rated").rating, EloRating::INITIAL_RATING);
+    const int aiGames = dbManager.getUserStats("AI").games;
+
+    QVERIFY(dbManager.saveGameHistoryBatch({aiGame("rated", "hard", "Player X wins!")}));
+    PlayerRating player = dbManager.getRating("rated");
+    PlayerRating aiRating = dbManager.getRating(ai);
+    QCOMPARE(player.rating, EloRating::INITIAL_RATING + EloRating::K_FACTOR / 2);
+    QCOMPARE(aiRating.rating, EloRating::INITIAL_RATING - EloRating::K_FACTOR / 2);
+    QCOMPARE(player.games, 1);
+    QCOMPARE(aiRating.games, 1);
+
+    // Neither an unknown result nor a game against oneself is rated
+    QVERIFY(dbManager.saveGameHistoryBatch({aiGame("rated", "hard", "Abandoned")}));
+    QVERIFY(dbManager.saveGameHistory("rated", "rated", "Player X wins!", {"0:0:X"}));
+    QCOMPARE(dbManager.getRating("rated").games, 1);
+
+    // A draw against a weaker opponent costs rating
+    QVERIFY(dbManager.saveGameHistoryBatch({aiGame("rated", "hard", "Draw")}));
+    QVERIFY(dbManager.getRating("rated").rating < player.rating);
+    QVERIFY(dbManager.getRating(ai).rating > aiRating.rating);
+
+    // History and totals still name the opponent plain "AI", as games from before difficulties were recorded do
+    QCOMPARE(dbManager.getUserStats("AI").games, aiGames + 3);
+    for (const QVariantMap &game : dbManager.loadGameHistory("rated")) {
+        QVERIFY(game["player2"].toString() == "AI" || game["player2"].toString() == "rated");
+    }
+}
+
+void TestDatabaseManager::testRecomputeRatings()
+{
+    DatabaseManager dbManager(this, "test_users.db");
+    const char* const results[] = {"Player X wins!", "AI wins!", "Draw", "Player O wins!"};
+    QVector<FinishedGame> games;
+    for (int i = 0; i < 40; ++i) {
+        const QString player = QString("replay%1").arg(i % 3);
+        games.append(i % 4 == 3 ? FinishedGame{player, "Player O", results[i % 4], GameRecord()}
+                                : aiGame(player, i % 2 ? "easy" : "hard", results[i % 4]));
+    }
+    QVERIFY(dbManager.saveGameHistoryBatch(games));
+    const QVector<PlayerRating> incremental = dbManager.topRatings(100);
+
+    QSqlQuery clear(dbManager.connection());
+    QVERIFY(clear.exec("DELETE FROM ratings"));
+    QVERIFY(dbManager.recomputeRatings());
+
+    const QVector<PlayerRating> replayed = dbManager.topRatings(100);
+    QCOMPARE(replayed.size(), incremental.size());
+    QCOMPARE(replayed.size(), 6); // Three players, two AI difficulties and "Player O"
+    for (int i = 0; i < replayed.size(); ++i) {
+        QCOMPARE(replayed[i].player, incremental[i].player);
+        QCOMPARE(replayed[i].games, incremental[i].games);
+        QVERIFY(qAbs(replayed[i].rating - incremental[i].rating) < 1e-9);
+    }
+}
+
+void TestDatabaseManager::testRatingsBackfilledOnUpgrade()
+{
+    QVector<PlayerRating> incremental;
+    {
+        DatabaseManager dbManager(this, "test_users.db");
+        QVERIFY(dbManager.saveGameHistoryBatch({aiGame("upgraded", "hard", "Player X wins!")}));
+        QVERIFY(dbManager.saveGameHistory("upgraded", "Player O", "Draw", {"0:0:X"}));
+        incremental = dbManager.topRatings(10);
+        QSqlQuery drop(dbManager.connection());
+        QVERIFY(drop.exec("DROP TABLE ratings")); // As in a database from before ratings
+    }
+
+    // Reopening creates the table and rates the stored games in the same transaction
+    DatabaseManager dbManager(this, "test_users.db");
+    const QVector<PlayerRating> backfilled = dbManager.topRatings(10);
+    QCOMPARE(backfilled.size(), incremental.size());
+    for (int i = 0; i < backfilled.size(); ++i) {
+        QCOMPARE(backfilled[i].player, incremental[i].player);
+        QCOMPARE(backfilled[i].games, incremental[i].games);
+    }
+}
+
+void TestDatabaseManager::testLeaderboard()
+{
+    DatabaseManager dbManager(this, "test_users.db");
+    const QString ai = DatabaseManager::aiPlayerName("mcts");
+    QVERIFY(dbManager.saveGameHistoryBatch({aiGame("champion", "mcts", "Player X wins!"),
+                                            aiGame("champion", "mcts", "Player X wins!"),
+                                            aiGame("beginner", "mcts", "AI wins!")}));
+
+    const QVector<PlayerRating> top = dbManager.topRatings(2);
+    QCOMPARE(top.size(), 2);
+    QCOMPARE(top[0].player, QString("champion"));
+    QCOMPARE(top[1].player, ai);
+    QVERIFY(top[0].rating > top[1].rating);
+
+    const QString plan = dbManager.explainLeaderboardQuery(10).join('\n');
+    QVERIFY2(plan.contains("ratings_by_rating"), qPrintable(plan));
+    QVERIFY2(!plan.contains("TEMP B-TREE"), qPrintable(plan));
 }
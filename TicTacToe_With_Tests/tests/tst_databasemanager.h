@@ -37,6 +37,31 @@ private slots:
     void testLoadGameHistory_noHistory();
     void testDeleteGameHistory();
     void testGetGameMoves();
+    void testMovesEncoding();
+    void testMigrateTextMoves();
+
+    // Tests for the prepared statement cache
+    void testStatementCache();
+
+    // Tests for the connection pool
+    void testConnectionPerThread();
+    void testReadersDoNotBlockWriter();
+
+    // Tests for the history indexes
+    void testHistoryQueryPlan();
+    void testHistoryIncludesBothSides();
+
+    // Tests for outcomes and user_stats
+    void testOutcomeFromResult();
+    void testUserStatsFollowHistory();
+    void testUserStatsMigration();
+
+    // Tests for ratings
+    void testEloRating();
+    void testRatingsFollowSaves();
+    void testRecomputeRatings();
+    void testRatingsBackfilledOnUpgrade();
+    void testLeaderboard();
 };
 
 #endif // TST_DATABASEMANAGER_H
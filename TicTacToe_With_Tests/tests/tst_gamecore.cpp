@@ -0,0 +1,92 @@
+#include "tst_gamecore.h"
+#include "GameCore.h"
+
+void TestGameCore::testTurnsAndInvalidMoves()
+{
+    GameCore core;
+    QCOMPARE(core.getCurrentPlayer(), Board::PLAYER_X);
+    QCOMPARE(core.getWinner(), GameCore::IN_PROGRESS);
+
+    QCOMPARE(core.playMove(1, 1), GameCore::MoveResult::Played);
+    QCOMPARE(core.getCurrentPlayer(), Board::PLAYER_O);
+
+    QCOMPARE(core.playMove(1, 1), GameCore::MoveResult::Invalid); // Occupied
+    QCOMPARE(core.playMove(3, 0), GameCore::MoveResult::Invalid); // Off the board
+    QCOMPARE(core.getCurrentPlayer(), Board::PLAYER_O); // Still O's turn
+    QCOMPARE(core.getMoves().size(), std::size_t(1));
+}
+
+void TestGameCore::testWinEndsGame()
+{
+    GameCore core;
+    core.playMove(0, 0); // X
+    core.playMove(1, 0); // O
+    core.playMove(0, 1); // X
+    core.playMove(1, 1); // O
+    QCOMPARE(core.playMove(0, 2), GameCore::MoveResult::Won);
+    QCOMPARE(core.getWinner(), Board::PLAYER_X);
+    QVERIFY(core.isOver());
+    QCOMPARE(core.getCurrentPlayer(), Board::PLAYER_X); // The turn does not pass after the last move
+
+    QCOMPARE(core.playMove(2, 2), GameCore::MoveResult::Invalid); // Nothing more can be played
+    QCOMPARE(core.getMoves().size(), std::size_t(5));
+
+    core.reset();
+    QVERIFY(!core.isOver());
+    QCOMPARE(core.getCurrentPlayer(), Board::PLAYER_X);
+    QVERIFY(core.getMoves().empty());
+    QCOMPARE(core.getBoard().getCell(0, 0), Board::EMPTY);
+}
+
+void TestGameCore::testDraw()
+{
+    GameCore core;
+    const int cells[9][2] = {{0, 0}, {1, 1}, {0, 2}, {0, 1}, {2, 1}, {2, 0}, {1, 0}, {2, 2}, {1, 2}};
+    for (int i = 0; i < 8; ++i) {
+        QCOMPARE(core.playMove(cells[i][0], cells[i][1]), GameCore::MoveResult::Played);
+    }
+    QCOMPARE(core.playMove(cells[8][0], cells[8][1]), GameCore::MoveResult::Drawn);
+    QCOMPARE(core.getWinner(), Board::EMPTY);
+    QVERIFY(core.isOver());
+}
+
+void TestGameCore::testMoveRecords()
+{
+    GameCore core;
+    core.playMove(2, 1); // X
+    core.playMove(0, 2); // O
+    const GameRecord& moves = core.getMoves();
+    QCOMPARE(moves.size(), std::size_t(2));
+    QCOMPARE(int(moves[0].row), 2);
+    QCOMPARE(int(moves[0].col), 1);
+    QCOMPARE(int(moves[0].player), Board::PLAYER_X);
+    QCOMPARE(int(moves[1].row), 0);
+    QCOMPARE(int(moves[1].col), 2);
+    QCOMPARE(int(moves[1].player), Board::PLAYER_O);
+    QCOMPARE(moves.cell(0), 7); // One byte per move: row * size + col
+    QCOMPARE(moves.cell(1), 2);
+
+    core.start(BoardVariant::Gomoku15x15);
+    core.playMove(14, 13);
+    QCOMPARE(core.getMoves().cell(0), 223);
+    QCOMPARE(int(core.getMoves()[0].row), 14);
+    QCOMPARE(int(core.getMoves()[0].col), 13);
+}
+
+void TestGameCore::testVariantSwitch()
+{
+    GameCore core;
+    core.start(BoardVariant::Grid4x4);
+    QCOMPARE(core.getVariant(), BoardVariant::Grid4x4);
+    for (int col = 0; col < 3; ++col) {
+        core.playMove(0, col); // X
+        core.playMove(1, col); // O
+    }
+    QVERIFY(!core.isOver()); // Three in a row is not enough on 4x4
+    QCOMPARE(core.playMove(0, 3), GameCore::MoveResult::Won);
+
+    core.start(BoardVariant::Classic3x3);
+    QCOMPARE(core.getVariant(), BoardVariant::Classic3x3);
+    QVERIFY(core.getMoves().empty());
+    QCOMPARE(core.playMove(3, 3), GameCore::MoveResult::Invalid);
+}
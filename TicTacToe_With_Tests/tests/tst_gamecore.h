@@ -0,0 +1,19 @@
+#ifndef TST_GAMECORE_H
+#define TST_GAMECORE_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class TestGameCore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testTurnsAndInvalidMoves();
+    void testWinEndsGame();
+    void testDraw();
+    void testMoveRecords();
+    void testVariantSwitch();
+};
+
+#endif // TST_GAMECORE_H
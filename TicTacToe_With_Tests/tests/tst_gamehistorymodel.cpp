@@ -0,0 +1,108 @@
+#include "tst_gamehistorymodel.h"
+#include "DatabaseManager.h"
+#include "GameHistoryModel.h"
+#include <QFile>
+
+namespace {
+const QString DATABASE_FILE = "test_history_model.db";
+
+// Saves `count` games for player in one transaction, so they all share a timestamp (and are told apart by id)
+void saveGames(DatabaseManager &database, const QString &player, int count)
+{
+    QVector<FinishedGame> games;
+    for (int i = 0; i < count; ++i) {
+        games.append(FinishedGame{player, "AI", QString("Game %1").arg(i), GameRecord()});
+        games.last().moves.appendCell(4);
+    }
+    QVERIFY(database.saveGameHistoryBatch(games));
+}
+}
+
+void TestGameHistoryModel::init()
+{
+    QFile::remove(DATABASE_FILE);
+}
+
+void TestGameHistoryModel::cleanup()
+{
+    QFile::remove(DATABASE_FILE);
+}
+
+void TestGameHistoryModel::testFetchesPageByPage()
+{
+    DatabaseManager database(this, DATABASE_FILE);
+    saveGames(database, "pager", 5);
+    saveGames(database, "someoneElse", 3);
+
+    GameHistoryModel model(&database, nullptr, 2);
+    model.setUser("pager");
+    QCOMPARE(model.rowCount(), 0); // Nothing is read until the view asks
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 2);
+    model.fetchMore(QModelIndex());
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 5);
+    QVERIFY(!model.canFetchMore(QModelIndex())); // The third page came back short
+
+    // Same games, in the same order, as loading the whole history at once
+    const QList<QVariantMap> history = database.loadGameHistory("pager");
+    QCOMPARE(history.size(), 5);
+    for (int row = 0; row < 5; ++row) {
+        QCOMPARE(model.gameId(row), history[row]["id"].toInt());
+        QCOMPARE(model.data(model.index(row), GameHistoryModel::GameIdRole).toInt(), history[row]["id"].toInt());
+    }
+}
+
+void TestGameHistoryModel::testPlaceholderWhenEmpty()
+{
+    DatabaseManager database(this, DATABASE_FILE);
+    GameHistoryModel model(&database);
+    model.setUser("nobody");
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.data(model.index(0)).toString(), QString("No game history available."));
+    QVERIFY(!model.data(model.index(0), GameHistoryModel::GameIdRole).isValid());
+    QCOMPARE(model.gameId(0), 0);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+}
+
+void TestGameHistoryModel::testRemoveGame()
+{
+    DatabaseManager database(this, DATABASE_FILE);
+    saveGames(database, "remover", 3);
+    const QList<QVariantMap> history = database.loadGameHistory("remover");
+
+    GameHistoryModel model(&database, nullptr, 2);
+    model.setUser("remover");
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 2);
+
+    // Removing the last loaded game does not lose the place the next page starts from
+    QVERIFY(database.deleteGameHistory(model.gameId(1)));
+    model.removeGame(1);
+    QCOMPARE(model.rowCount(), 1);
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.gameId(1), history[2]["id"].toInt());
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    model.removeGame(1);
+    model.removeGame(0);
+    QCOMPARE(model.rowCount(), 1); // The placeholder
+    QCOMPARE(model.gameId(0), 0);
+}
+
+void TestGameHistoryModel::testDisplayText()
+{
+    DatabaseManager database(this, DATABASE_FILE);
+    QVERIFY(database.saveGameHistory("host", "guest", "Player X wins!", {"1:1:X"}));
+
+    GameHistoryModel model(&database);
+    model.setUser("guest");
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 1);
+    const QString text = model.data(model.index(0)).toString();
+    QVERIFY2(text.startsWith("vs host | Result: Player X wins! | On: "), qPrintable(text));
+}
@@ -0,0 +1,21 @@
+#ifndef TST_GAMEHISTORYMODEL_H
+#define TST_GAMEHISTORYMODEL_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class TestGameHistoryModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();    // Fresh database file before each test
+    void cleanup();
+
+    void testFetchesPageByPage();
+    void testPlaceholderWhenEmpty();
+    void testRemoveGame();
+    void testDisplayText();
+};
+
+#endif // TST_GAMEHISTORYMODEL_H
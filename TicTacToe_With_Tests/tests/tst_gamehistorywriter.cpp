@@ -0,0 +1,105 @@
+#include "tst_gamehistorywriter.h"
+#include "DatabaseManager.h"
+#include "GameHistoryWriter.h"
+#include <QFile>
+#include <QSignalSpy>
+#include <QSqlQuery>
+#include <QThread>
+
+namespace {
+const QString DATABASE_FILE = "test_history_writer.db";
+
+FinishedGame sampleGame(const QString& player)
+{
+    FinishedGame game{player, "AI", "Draw", GameRecord()};
+    for (int cell : {4, 0, 2, 6, 3, 5, 1, 7, 8}) {
+        game.moves.appendCell(cell);
+    }
+    return game;
+}
+}
+
+void TestGameHistoryWriter::init()
+{
+    QFile::remove(DATABASE_FILE);
+}
+
+void TestGameHistoryWriter::cleanup()
+{
+    QFile::remove(DATABASE_FILE);
+}
+
+void TestGameHistoryWriter::testWritesQueuedGames()
+{
+    GameHistoryWriter writer(DATABASE_FILE);
+    for (int i = 0; i < 300; ++i) {
+        writer.enqueue(sampleGame("writer"));
+    }
+    writer.flush();
+    QCOMPARE(writer.savedGameCount(), quint64(300));
+    QCOMPARE(writer.failedGameCount(), quint64(0));
+    QVERIFY(writer.committedBatchCount() >= 1);
+    QVERIFY(writer.committedBatchCount() <= 300); // Games that queued up together shared a transaction
+
+    DatabaseManager dbManager(this, DATABASE_FILE);
+    QList<QVariantMap> history = dbManager.loadGameHistory("writer");
+    QCOMPARE(history.size(), 300);
+    QVERIFY(dbManager.getGameRecord(history[0]["id"].toInt()) == sampleGame("writer").moves);
+}
+
+void TestGameHistoryWriter::testDestructorFlushes()
+{
+    {
+        GameHistoryWriter writer(DATABASE_FILE);
+        for (int i = 0; i < 50; ++i) {
+            writer.enqueue(sampleGame("shutdown"));
+        }
+    } // No flush(): destroying the writer must still save everything
+
+    DatabaseManager dbManager(this, DATABASE_FILE);
+    QCOMPARE(dbManager.loadGameHistory("shutdown").size(), 50);
+}
+
+void TestGameHistoryWriter::testBackPressure()
+{
+    DatabaseManager dbManager(this, DATABASE_FILE);
+    QSqlQuery lock(dbManager.connection());
+    QVERIFY(lock.exec("BEGIN EXCLUSIVE")); // The writer's next transaction waits for this one
+
+    const int capacity = 2;
+    GameHistoryWriter writer(DATABASE_FILE, nullptr, capacity);
+    int accepted = 0;
+    for (int attempt = 0; attempt < 100 && writer.tryEnqueue(sampleGame("pressure")); ++attempt) {
+        ++accepted;
+        QThread::msleep(10); // Give the writer time to take the queue and block on the lock
+    }
+    // At most one batch left the queue before the writer got stuck; after that the queue filled up
+    QVERIFY(accepted >= capacity);
+    QVERIFY(accepted <= 2 * capacity);
+
+    QVERIFY(lock.exec("COMMIT"));
+    writer.flush();
+    QCOMPARE(writer.savedGameCount(), quint64(accepted));
+    QCOMPARE(dbManager.loadGameHistory("pressure").size(), accepted);
+}
+
+void TestGameHistoryWriter::testRejectedGameFailsAlone()
+{
+    DatabaseManager dbManager(this, DATABASE_FILE);
+    QSqlQuery reject(dbManager.connection());
+    QVERIFY(reject.exec("CREATE TRIGGER reject_game BEFORE INSERT ON game_history WHEN NEW.player1 = 'rejected' "
+                        "BEGIN SELECT RAISE(ABORT, 'rejected'); END"));
+
+    GameHistoryWriter writer(DATABASE_FILE);
+    QSignalSpy failed(&writer, &GameHistoryWriter::gamesFailed);
+    writer.enqueue(sampleGame("kept"));
+    writer.enqueue(sampleGame("rejected"));
+    writer.enqueue(sampleGame("kept"));
+    writer.flush(); // Whether or not the three shared a batch, only the rejected game may be lost
+
+    QCOMPARE(writer.savedGameCount(), quint64(2));
+    QCOMPARE(writer.failedGameCount(), quint64(1));
+    QCOMPARE(dbManager.loadGameHistory("kept").size(), 2);
+    QCOMPARE(failed.count(), 1);
+    QCOMPARE(failed.takeFirst().at(0).toInt(), 1);
+}
@@ -0,0 +1,21 @@
+#ifndef TST_GAMEHISTORYWRITER_H
+#define TST_GAMEHISTORYWRITER_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class TestGameHistoryWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();    // Fresh database file before each test
+    void cleanup();
+
+    void testWritesQueuedGames();
+    void testDestructorFlushes();
+    void testBackPressure();
+    void testRejectedGameFailsAlone();
+};
+
+#endif // TST_GAMEHISTORYWRITER_H
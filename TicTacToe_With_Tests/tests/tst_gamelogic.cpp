@@ -77,7 +77,7 @@ void TestGameLogic::testResetGame()
     logic.handlePlayerMove(0, 0);
     logic.resetGame();
     QCOMPARE(logic.getCurrentPlayer(), Board::PLAYER_X);
-    QCOMPARE(logic.getMoveHistory().count(), 0);
+    QVERIFY(logic.getMoveHistory().empty());
     // Add a check to ensure the board is actually reset (e.g., all cells are empty)
     // This would require a getter for the board state in GameLogic or Board class
 }
@@ -131,4 +131,41 @@ void TestGameLogic::testIsVsAI()
     QCOMPARE(logic.isVsAI(), true);
 }
 
-#include "tst_gamelogic.moc"
+void TestGameLogic::testLargerBoardVariant()
+{
+    GameLogic logic;
+    logic.startGame(false, "", BoardVariant::Grid4x4);
+    QCOMPARE(logic.getBoardVariant(), BoardVariant::Grid4x4);
+
+    // Three in a row no longer wins on a 4x4 board
+    logic.handlePlayerMove(0, 0); // X
+    logic.handlePlayerMove(1, 0); // O
+    logic.handlePlayerMove(0, 1); // X
+    logic.handlePlayerMove(1, 1); // O
+    logic.handlePlayerMove(0, 2); // X
+    QCOMPARE(logic.getWinner(), -2);
+    logic.handlePlayerMove(1, 2); // O
+    QVERIFY(logic.handlePlayerMove(0, 3)); // X completes four in a row
+    QCOMPARE(logic.getWinner(), Board::PLAYER_X);
+
+    // Starting a classic game switches back to 3x3
+    logic.startGame(false, "");
+    QCOMPARE(logic.getBoardVariant(), BoardVariant::Classic3x3);
+    QVERIFY(!logic.handlePlayerMove(3, 3)); // Off the 3x3 board
+}
+
+void TestGameLogic::testResetDiscardsPendingAiMove()
+{
+    GameLogic logic;
+    QSignalSpy boardSpy(&logic, &GameLogic::boardChanged);
+    logic.startGame(true, "hard");
+
+    QVERIFY(logic.handlePlayerMove(1, 1)); // X; the AI starts thinking in the background
+    QCOMPARE(logic.getCurrentPlayer(), Board::PLAYER_O);
+    logic.resetGame(); // New game before the AI answered
+
+    QTest::qWait(1000); // Longer than the AI's presentation delay
+    QCOMPARE(boardSpy.count(), 1); // Only the human move ever reached the board
+    QCOMPARE(logic.getCurrentPlayer(), Board::PLAYER_X);
+    QVERIFY(logic.getMoveHistory().empty());
+}
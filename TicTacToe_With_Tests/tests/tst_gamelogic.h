@@ -20,6 +20,8 @@ private slots:
     void testGetCurrentPlayer();
     void testGetWinner();
     void testIsVsAI();
+    void testLargerBoardVariant();
+    void testResetDiscardsPendingAiMove();
 
 };
 
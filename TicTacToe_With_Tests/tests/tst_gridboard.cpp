@@ -0,0 +1,88 @@
+#include "tst_gridboard.h"
+#include "GridBoard.h"
+#include "AnyBoard.h"
+
+void TestGridBoard::testRowWinOnLargeBoard()
+{
+    GridBoard<15, 5> board;
+    for (int col = 3; col < 7; ++col) {
+        QVERIFY(board.makeMove(7, col, Board::PLAYER_X));
+        QCOMPARE(board.checkWin(), Board::EMPTY); // Four in a row is not enough
+    }
+    board.makeMove(7, 8, Board::PLAYER_X);
+    QCOMPARE(board.checkWin(), Board::EMPTY); // Gap at column 7
+
+    board.makeMove(7, 7, Board::PLAYER_X); // Fills the gap: columns 3..8
+    QCOMPARE(board.checkWin(), Board::PLAYER_X);
+    QVERIFY(!board.makeMove(7, 7, Board::PLAYER_O)); // Already occupied
+    QVERIFY(!board.makeMove(15, 0, Board::PLAYER_O)); // Out of bounds
+}
+
+void TestGridBoard::testDiagonalWins()
+{
+    GridBoard<5, 4> board;
+    board.makeMove(0, 3, Board::PLAYER_O);
+    board.makeMove(1, 2, Board::PLAYER_O);
+    board.makeMove(2, 1, Board::PLAYER_O);
+    QCOMPARE(board.checkWin(), Board::EMPTY);
+    board.makeMove(3, 0, Board::PLAYER_O);
+    QCOMPARE(board.checkWin(), Board::PLAYER_O); // Anti-diagonal
+
+    GridBoard<4, 4> small;
+    for (int i = 0; i < 4; ++i) {
+        small.makeMove(i, i, Board::PLAYER_X);
+    }
+    QCOMPARE(small.checkWin(), Board::PLAYER_X); // Main diagonal
+}
+
+void TestGridBoard::testUndoClearsWinner()
+{
+    GridBoard<4, 4> board;
+    for (int row = 0; row < 4; ++row) {
+        board.makeMove(row, 2, Board::PLAYER_X);
+    }
+    QCOMPARE(board.checkWin(), Board::PLAYER_X);
+    const Board::Hash wonHash = board.getHash();
+
+    board.undoMove(3, 2);
+    QCOMPARE(board.checkWin(), Board::EMPTY);
+    QCOMPARE(board.getCell(3, 2), Board::EMPTY);
+    QCOMPARE(board.getMoveCount(), 3);
+
+    board.makeMove(3, 2, Board::PLAYER_X);
+    QCOMPARE(board.checkWin(), Board::PLAYER_X);
+    QCOMPARE(board.getHash(), wonHash);
+}
+
+void TestGridBoard::testIsFull()
+{
+    GridBoard<4, 4> board;
+    for (int cell = 0; cell < 16; ++cell) {
+        QVERIFY(!board.isFull());
+        board.makeMove(cell / 4, cell % 4, (cell / 2) % 2 == 0 ? Board::PLAYER_X : Board::PLAYER_O);
+    }
+    QVERIFY(board.isFull());
+    board.reset();
+    QVERIFY(!board.isFull());
+    QCOMPARE(board.getMoveCount(), 0);
+}
+
+void TestGridBoard::testAnyBoardVariants()
+{
+    AnyBoard classic;
+    QCOMPARE(classic.getVariant(), BoardVariant::Classic3x3);
+    QVERIFY(classic.classic() != nullptr);
+    QCOMPARE(classic.size(), 3);
+
+    AnyBoard gomoku(BoardVariant::Gomoku15x15);
+    QVERIFY(gomoku.classic() == nullptr);
+    QCOMPARE(gomoku.size(), 15);
+    QCOMPARE(gomoku.winLength(), 5);
+    QVERIFY(gomoku.makeMove(14, 14, Board::PLAYER_O));
+    QCOMPARE(gomoku.getCell(14, 14), Board::PLAYER_O);
+    QVERIFY(!gomoku.isFull());
+
+    AnyBoard grid(BoardVariant::Grid5x5);
+    QCOMPARE(grid.size(), 5);
+    QCOMPARE(grid.winLength(), 4);
+}
@@ -0,0 +1,19 @@
+#ifndef TST_GRIDBOARD_H
+#define TST_GRIDBOARD_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class TestGridBoard : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRowWinOnLargeBoard();
+    void testDiagonalWins();
+    void testUndoClearsWinner();
+    void testIsFull();
+    void testAnyBoardVariants();
+};
+
+#endif // TST_GRIDBOARD_H
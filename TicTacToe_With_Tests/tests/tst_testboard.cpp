@@ -125,3 +125,75 @@ void TestBoard::testResetBoard()
         }
     }
 }
+
+void TestBoard::testPlayerMasks()
+{
+    Board board;
+    board.makeMove(0, 0, Board::PLAYER_X);
+    board.makeMove(1, 1, Board::PLAYER_O);
+    board.makeMove(2, 2, Board::PLAYER_X);
+
+    QCOMPARE(board.getPlayerMask(Board::PLAYER_X), Board::Mask(0x111));
+    QCOMPARE(board.getPlayerMask(Board::PLAYER_O), Board::Mask(0x010));
+    QCOMPARE(board.getOccupiedMask(), Board::Mask(0x111 | 0x010));
+    QVERIFY(Board::hasLine(board.getPlayerMask(Board::PLAYER_X) | board.getPlayerMask(Board::PLAYER_O)));
+    QCOMPARE(board.checkWin(), Board::EMPTY); // X only has two corners, the centre belongs to O
+}
+
+void TestBoard::testZobristHashIsIncremental()
+{
+    Board empty;
+    Board board;
+    board.makeMove(1, 1, Board::PLAYER_X);
+    board.makeMove(0, 2, Board::PLAYER_O);
+
+    // Same position reached through a different move order hashes the same
+    Board transposed;
+    transposed.makeMove(0, 2, Board::PLAYER_O);
+    transposed.makeMove(1, 1, Board::PLAYER_X);
+    QCOMPARE(board.getHash(), transposed.getHash());
+    QVERIFY(board.getHash() != empty.getHash());
+
+    // Undoing every move brings the hash back to the empty board
+    board.undoMove(0, 2);
+    board.undoMove(1, 1);
+    QCOMPARE(board.getHash(), empty.getHash());
+
+    board.makeMove(2, 2, Board::PLAYER_X);
+    board.reset();
+    QCOMPARE(board.getHash(), empty.getHash());
+}
+
+void TestBoard::testCanonicalFormUnderSymmetry()
+{
+    // X in a corner with O next to it, and the same shape rotated a quarter turn clockwise
+    Board board;
+    board.makeMove(0, 0, Board::PLAYER_X);
+    board.makeMove(0, 1, Board::PLAYER_O);
+    Board rotated;
+    rotated.makeMove(0, 2, Board::PLAYER_X);
+    rotated.makeMove(1, 2, Board::PLAYER_O);
+
+    const Board::CanonicalForm form = board.canonicalForm();
+    const Board::CanonicalForm rotatedForm = rotated.canonicalForm();
+    QCOMPARE(form.key, rotatedForm.key);
+    QVERIFY(form.key <= board.pack());
+
+    // The reported transform really maps each board onto the canonical key
+    QCOMPARE(Board::transformMask(rotated.getPlayerMask(Board::PLAYER_X), rotatedForm.transform),
+             Board::Mask(form.key & Board::FULL_MASK));
+
+    // A move picked on the canonical board maps back to the matching cell on each original board
+    const int canonicalCell = Board::transformCell(2 * 3 + 2, form.transform); // Opposite corner to X
+    QCOMPARE(Board::inverseTransformCell(canonicalCell, form.transform), 2 * 3 + 2);
+    const int rotatedCell = Board::inverseTransformCell(canonicalCell, rotatedForm.transform);
+    QCOMPARE(rotatedCell, 2 * 3 + 0); // Opposite corner to X on the rotated board
+
+    // All 8 symmetries of the empty board and of the centre-only board are the same position
+    Board centre;
+    centre.makeMove(1, 1, Board::PLAYER_X);
+    for (int t = 0; t < Board::SYMMETRY_COUNT; ++t) {
+        QCOMPARE(Board::transformCell(4, t), 4);
+    }
+    QCOMPARE(centre.canonicalForm().key, centre.pack());
+}
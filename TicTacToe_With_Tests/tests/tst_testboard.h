@@ -24,6 +24,9 @@ private slots:
     void testCheckWinNoWin();
     void testIsFull();
     void testResetBoard();
+    void testPlayerMasks();
+    void testZobristHashIsIncremental();
+    void testCanonicalFormUnderSymmetry();
 };
 
 #endif // TST_TESTBOARD_H
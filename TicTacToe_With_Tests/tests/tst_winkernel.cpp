@@ -0,0 +1,87 @@
+#include "tst_winkernel.h"
+#include "WinKernel.h"
+#include <vector>
+
+namespace {
+
+// Every packed position where no cell holds both marks (reachable or not: the kernel does not care)
+std::vector<Board::PackedPosition> allPositions()
+{
+    std::vector<Board::PackedPosition> positions;
+    for (Board::PackedPosition packed = 0; packed < (1u << 18); ++packed) {
+        if ((packed & Board::FULL_MASK & (packed >> 9)) == 0) {
+            positions.push_back(packed);
+        }
+    }
+    return positions;
+}
+
+Board unpack(Board::PackedPosition packed)
+{
+    Board board;
+    for (int cell = 0; cell < 9; ++cell) {
+        if (packed & (1u << cell)) {
+            board.makeMove(cell / 3, cell % 3, Board::PLAYER_X);
+        } else if (packed & (1u << (cell + 9))) {
+            board.makeMove(cell / 3, cell % 3, Board::PLAYER_O);
+        }
+    }
+    return board;
+}
+
+std::uint8_t expectedStatus(const Board& board)
+{
+    std::uint8_t status = 0;
+    if (Board::hasLine(board.getPlayerMask(Board::PLAYER_X))) status |= WinKernel::X_LINE;
+    if (Board::hasLine(board.getPlayerMask(Board::PLAYER_O))) status |= WinKernel::O_LINE;
+    if (board.isFull()) status |= WinKernel::FULL;
+    return status;
+}
+
+const WinKernel::Implementation IMPLEMENTATIONS[] = {
+    WinKernel::Implementation::Scalar,
+    WinKernel::Implementation::Sse41,
+    WinKernel::Implementation::Avx2
+};
+}
+
+void TestWinKernel::testMatchesCheckWin()
+{
+    const std::vector<Board::PackedPosition> positions = allPositions();
+    for (WinKernel::Implementation implementation : IMPLEMENTATIONS) {
+        if (!WinKernel::isSupported(implementation)) {
+            continue; // Nothing to run on this CPU
+        }
+        std::vector<std::uint8_t> status(positions.size());
+        WinKernel::classify(implementation, positions.data(), positions.size(), status.data());
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            const Board board = unpack(positions[i]);
+            QCOMPARE(status[i], expectedStatus(board));
+            if (!(status[i] & WinKernel::X_LINE) || !(status[i] & WinKernel::O_LINE)) {
+                QCOMPARE(WinKernel::winner(status[i]), board.checkWin()); // Both lines: only possible off the game tree
+            }
+        }
+    }
+    QVERIFY(WinKernel::isSupported(WinKernel::bestImplementation()));
+}
+
+void TestWinKernel::testUnalignedTail()
+{
+    // Counts that are not a multiple of the SIMD width must finish the last boards on the scalar path
+    const Board::PackedPosition won = Board::WIN_MASKS[0];
+    const Board::PackedPosition drawn = 0x18D | (0x072 << 9); // X O X / X O O / O X X
+    const Board::PackedPosition open = 0x010;
+    const Board::PackedPosition positions[11] = {open, won, drawn, open, won, drawn, open, won, drawn, open, won << 9};
+    for (WinKernel::Implementation implementation : IMPLEMENTATIONS) {
+        if (!WinKernel::isSupported(implementation)) {
+            continue;
+        }
+        std::uint8_t status[12] = {};
+        status[11] = 0xAA; // Sentinel past the end
+        WinKernel::classify(implementation, positions, 11, status);
+        for (int i = 0; i < 11; ++i) {
+            QCOMPARE(status[i], expectedStatus(unpack(positions[i])));
+        }
+        QCOMPARE(status[11], std::uint8_t(0xAA));
+    }
+}
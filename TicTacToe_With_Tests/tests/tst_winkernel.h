@@ -0,0 +1,16 @@
+#ifndef TST_WINKERNEL_H
+#define TST_WINKERNEL_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class TestWinKernel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testMatchesCheckWin();
+    void testUnalignedTail();
+};
+
+#endif // TST_WINKERNEL_H